@@ -0,0 +1,95 @@
+/*
+Purpose: Bump allocator for mesh storage.
+	Allocations are carved out of large chunks and are never freed one by
+		one, the whole arena is released at once on reset or destruction.
+	Holding many Shapes in one arena keeps their data packed together and
+		makes the memory used by a scene a single predictable number.
+	When a chunk is full a new one is chained on, at least as large as the
+		request, so earlier allocations never move.
+*/
+
+#ifndef __ARENA__
+#define __ARENA__
+
+#include <cstddef>
+#include <cstdint>
+
+class Arena final
+{
+public:
+	Arena(size_t chunkSize = 1 << 20) : chunkSize(chunkSize)
+	{
+		//NULL
+	}
+	~Arena()
+	{
+		release();
+	}
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+	void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+	{
+		if (head != nullptr)
+		{
+			size_t offset = align(head->offset, alignment);
+			if (offset + bytes <= head->size)
+			{
+				head->offset = offset + bytes;
+				usedBytes += bytes;
+				return head->data + offset;
+			}
+		}
+		//New chunk, new char[] is aligned for any fundamental type
+		Chunk* chunk = new Chunk;
+		chunk->size = (bytes > chunkSize) ? bytes : chunkSize;
+		chunk->data = new char[chunk->size];
+		chunk->offset = bytes;
+		chunk->next = head;
+		head = chunk;
+		reservedBytes += chunk->size;
+		usedBytes += bytes;
+		return chunk->data;
+	}
+	void reset()
+	{//invalidates every allocation made from this arena
+		release();
+	}
+	size_t used() const
+	{
+		return usedBytes;
+	}
+	size_t reserved() const
+	{
+		return reservedBytes;
+	}
+private:
+	struct Chunk
+	{
+		char* data;
+		size_t size;
+		size_t offset;
+		Chunk* next;
+	};
+	static size_t align(size_t offset, size_t alignment)
+	{
+		return (offset + (alignment - 1)) & ~(alignment - 1);
+	}
+	void release()
+	{
+		while (head != nullptr)
+		{
+			Chunk* next = head->next;
+			delete[] head->data;
+			delete head;
+			head = next;
+		}
+		usedBytes = 0;
+		reservedBytes = 0;
+	}
+	const size_t chunkSize;
+	Chunk* head = nullptr;
+	size_t reservedBytes = 0;
+	size_t usedBytes = 0;
+};
+
+#endif
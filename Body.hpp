@@ -0,0 +1,96 @@
+/*
+Purpose: Instanced bodies sharing one immutable copy of their mesh.
+	Geometry (vertices, adjacency, faces and normals) is built once, then
+		frozen behind a reference counted pointer to a const tShape.
+	A body only holds that pointer and its transform, so thousands of
+		identical bodies cost a transform each plus one shared mesh.
+	The geometry is released with the last body referencing it, shapes
+		stored in an Arena are copied out of it when shared so they never
+		depend on the arena outliving their bodies.
+	Any per mesh preparation (buildAdjacency, buildSupportCache) must happen
+		before the shape is shared, since shared geometry cannot change.
+*/
+
+#ifndef __BODY__
+#define __BODY__
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include "VectorMath.hpp"
+#include "Shape.hpp"
+#include "GJK.hpp"
+
+template <typename T>
+using tGeometry = std::shared_ptr<const tShape<T>>;
+
+typedef tGeometry<float> Geometry;
+
+//Moves a finished shape into shared, immutable storage, arena backed shapes are copied to their own heap block instead
+template <typename T>
+tGeometry<T> shareGeometry(tShape<T>&& shape)
+{
+	if (!shape.ownsMemory())return std::make_shared<const tShape<T>>(static_cast<const tShape<T>&>(shape));
+	return std::make_shared<const tShape<T>>(std::move(shape));
+}
+
+template <typename T>
+class tBody
+{
+public:
+	tBody()
+	{
+		//NULL
+	}
+	tBody(const tGeometry<T>& geometry_, const ttransform<T>& placement_ = ttransform<T>()) : geometry(geometry_), placement(placement_)
+	{
+		//NULL
+	}
+	const tShape<T>& shape() const
+	{
+		return *geometry;
+	}
+	tvec3<T> worldVertex(const uint32_t& index) const
+	{
+		return transformPoint(placement, geometry->vertices[index]);
+	}
+	tGeometry<T> geometry;
+	ttransform<T> placement;
+};
+
+typedef tBody<float> Body;
+typedef tBody<double> dBody;
+
+template <typename T>
+T gjkDistance(const tBody<T>& A, const tBody<T>& B, uint32_t* iterations = nullptr, const T cullDistance = std::numeric_limits<T>::max())
+{
+	return gjkDistance(*A.geometry, *B.geometry, inverse(A.placement) * B.placement, iterations, cullDistance);
+}
+
+//Closest points are in A's local frame
+template <typename T>
+tDistanceResult<T> gjkClosestPoints(const tBody<T>& A, const tBody<T>& B, const T cullDistance = std::numeric_limits<T>::max())
+{
+	return gjkClosestPoints(*A.geometry, *B.geometry, inverse(A.placement) * B.placement, cullDistance);
+}
+
+template <typename T>
+bool gjkWithinMargin(const tBody<T>& A, const tBody<T>& B, const T margin, uint32_t* iterations = nullptr)
+{
+	return gjkWithinMargin(*A.geometry, *B.geometry, inverse(A.placement) * B.placement, margin, iterations);
+}
+
+template <typename T>
+bool gjkIntersect(const tBody<T>& A, const tBody<T>& B, uint32_t* iterations = nullptr)
+{
+	return gjkWithinMargin(*A.geometry, *B.geometry, inverse(A.placement) * B.placement, T(0), iterations);
+}
+
+//bVelocity is in world space, relative to A
+template <typename T>
+std::pair<T, T> gjkToI(const tBody<T>& A, const tBody<T>& B, const tvec3<T>& bVelocity, uint32_t* bisections = nullptr)
+{
+	return gjkToI(*A.geometry, A.placement, *B.geometry, B.placement, bVelocity, bisections);
+}
+
+#endif
@@ -0,0 +1,417 @@
+/*
+Purpose: Chains of simplified convex proxies for conservative collision tests.
+	Each level is built from the source mesh by quadric error edge collapse,
+		which keeps the vertices that best preserve the surface, followed by
+		the convex hull of what is left.
+		The hull is then scaled about its center until every source vertex lies
+		inside it, so a proxy always encloses the shape it stands in for.
+	Level 0 is the source shape itself, every level above holds about a
+		quarter of the vertices of the one below until only a few remain.
+	Because proxies enclose, a proxy that never reaches another over a time
+		step rules out contact for the finer shapes, and the time a proxy makes
+		contact is a lower bound on the time the finer shapes do.
+		gjkToI on two chains runs from the coarsest level down, and only gets
+		to the full meshes for pairs that actually come near each other.
+	Collapse runs in double, the source should be a closed triangulated mesh,
+		e.g. the output of convexHull.
+*/
+
+#ifndef __COLLISION_LOD__
+#define __COLLISION_LOD__
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "Arena.hpp"
+#include "VectorMath.hpp"
+#include "Shape.hpp"
+#include "Hull.hpp"
+#include "GJK.hpp"
+
+//Symmetric 4x4 error quadric of a set of planes, stored as its upper triangle
+struct Quadric
+{
+	double q[10] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+	void addPlane(const dvec3& normal, const double offset)
+	{
+		const double p[4] = { normal.x, normal.y, normal.z, -offset };
+		int k = 0;
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = i; j < 4; ++j)
+			{
+				q[k++] += p[i] * p[j];
+			}
+		}
+	}
+	Quadric operator+(const Quadric& other) const
+	{
+		Quadric sum;
+		for (int i = 0; i < 10; ++i)
+		{
+			sum.q[i] = q[i] + other.q[i];
+		}
+		return sum;
+	}
+	//Sum of squared distances from p to the planes
+	double error(const dvec3& p) const
+	{
+		return q[0] * p.x * p.x + 2.0 * q[1] * p.x * p.y + 2.0 * q[2] * p.x * p.z + 2.0 * q[3] * p.x
+			+ q[4] * p.y * p.y + 2.0 * q[5] * p.y * p.z + 2.0 * q[6] * p.y
+			+ q[7] * p.z * p.z + 2.0 * q[8] * p.z
+			+ q[9];
+	}
+	//Point of least error, false when the planes do not pin one down
+	bool minimum(dvec3& p) const
+	{
+		double a = q[0], b = q[1], c = q[2], d = q[4], e = q[5], f = q[7];
+		double det = a * (d * f - e * e) - b * (b * f - e * c) + c * (b * e - d * c);
+		double scale = std::fabs(a) + std::fabs(d) + std::fabs(f);
+		if (std::fabs(det) <= 1e-9 * scale * scale * scale)return false;
+		double inverse = 1.0 / det;
+		double x = -q[3], y = -q[6], z = -q[8];
+		p.x = ((d * f - e * e) * x - (b * f - c * e) * y + (b * e - c * d) * z) * inverse;
+		p.y = (-(b * f - e * c) * x + (a * f - c * c) * y - (a * e - b * c) * z) * inverse;
+		p.z = ((b * e - d * c) * x - (a * e - b * c) * y + (a * d - b * b) * z) * inverse;
+		return true;
+	}
+};
+
+struct CollapseCandidate
+{
+	double cost;
+	int keep, remove;
+	uint32_t keepStamp, removeStamp;
+	bool operator>(const CollapseCandidate& other) const
+	{
+		return cost > other.cost;
+	}
+};
+
+//Distinct vertices sharing a live face with v
+inline void collapseNeighbors(const std::vector<Indices3>& faceVerts, const std::vector<char>& faceAlive, const std::vector<int>& incident, int v, std::vector<int>& out)
+{
+	out.clear();
+	for (int f : incident)
+	{
+		if (!faceAlive[f])continue;
+		for (int k = 0; k < 3; ++k)
+		{
+			int n = faceVerts[f].ind[k];
+			if (n == v)continue;
+			bool repeated = false;
+			for (int m : out)
+			{
+				if (m == n)repeated = true;
+			}
+			if (!repeated)out.push_back(n);
+		}
+	}
+}
+
+//Position replacing the edge a, b and the error it adds
+inline dvec3 collapsePoint(const std::vector<Quadric>& quadrics, const std::vector<dvec3>& positions, int a, int b, double& cost)
+{
+	Quadric sum = quadrics[a] + quadrics[b];
+	dvec3 point;
+	if (!sum.minimum(point))
+	{
+		//Flat regions leave the system singular, fall back to the ends and the middle
+		dvec3 options[3] = { positions[a], positions[b], (positions[a] + positions[b]) * 0.5 };
+		point = options[0];
+		for (int i = 1; i < 3; ++i)
+		{
+			if (sum.error(options[i]) < sum.error(point))point = options[i];
+		}
+	}
+	cost = sum.error(point);
+	return point;
+}
+
+//Collapses the mesh's edges, cheapest first, until at most targetCount vertices remain
+template <typename T>
+std::vector<dvec3> collapseVertices(const tShape<T>& source, int targetCount)
+{
+	int N = source.count;
+	std::vector<dvec3> positions(N);
+	std::vector<Quadric> quadrics(N);
+	std::vector<std::vector<int>> vertexFaces(N);
+	std::vector<Indices3> faceVerts(source.faceVerts, source.faceVerts + source.faceCount);
+	std::vector<char> faceAlive(source.faceCount, 1);
+	for (int i = 0; i < N; ++i)
+	{
+		positions[i] = dvec3(source.vertices[i]);
+	}
+	for (int i = 0; i < source.faceCount; ++i)
+	{
+		const Indices3& face = faceVerts[i];
+		dvec3 normal = cross(positions[face.ind[1]] - positions[face.ind[0]], positions[face.ind[2]] - positions[face.ind[0]]);
+		double length = std::sqrt(dot(normal, normal));
+		if (length == 0.0)continue;
+		normal = normal * (1.0 / length);
+		double offset = dot(normal, positions[face.ind[0]]);
+		for (int k = 0; k < 3; ++k)
+		{
+			quadrics[face.ind[k]].addPlane(normal, offset);
+			vertexFaces[face.ind[k]].push_back(i);
+		}
+	}
+	std::vector<char> alive(N, 1);
+	std::vector<uint32_t> stamps(N, 0);
+	std::priority_queue<CollapseCandidate, std::vector<CollapseCandidate>, std::greater<CollapseCandidate>> queue;
+	std::vector<int> ring;
+	for (int v = 0; v < N; ++v)
+	{
+		collapseNeighbors(faceVerts, faceAlive, vertexFaces[v], v, ring);
+		for (int n : ring)
+		{
+			if (n < v)continue;
+			CollapseCandidate candidate;
+			collapsePoint(quadrics, positions, v, n, candidate.cost);
+			candidate.keep = v;
+			candidate.remove = n;
+			candidate.keepStamp = candidate.removeStamp = 0;
+			queue.push(candidate);
+		}
+	}
+	int remaining = N;
+	while (remaining > targetCount && !queue.empty())
+	{
+		CollapseCandidate top = queue.top();
+		queue.pop();
+		int a = top.keep, b = top.remove;
+		//Stale once either end has moved or been removed since it was queued
+		if (!alive[a] || !alive[b] || stamps[a] != top.keepStamp || stamps[b] != top.removeStamp)continue;
+		double cost;
+		positions[a] = collapsePoint(quadrics, positions, a, b, cost);
+		quadrics[a] = quadrics[a] + quadrics[b];
+		alive[b] = 0;
+		--remaining;
+		for (int f : vertexFaces[b])
+		{
+			if (!faceAlive[f])continue;
+			Indices3& face = faceVerts[f];
+			if (face.ind[0] == a || face.ind[1] == a || face.ind[2] == a)
+			{
+				faceAlive[f] = 0;
+				continue;
+			}
+			for (int k = 0; k < 3; ++k)
+			{
+				if (face.ind[k] == b)face.ind[k] = a;
+			}
+			vertexFaces[a].push_back(f);
+		}
+		++stamps[a];
+		collapseNeighbors(faceVerts, faceAlive, vertexFaces[a], a, ring);
+		for (int n : ring)
+		{
+			++stamps[n];
+		}
+		//Every edge around the moved vertex changed cost, requeue them all
+		for (int n : ring)
+		{
+			std::vector<int> outer;
+			collapseNeighbors(faceVerts, faceAlive, vertexFaces[n], n, outer);
+			for (int m : outer)
+			{
+				CollapseCandidate candidate;
+				collapsePoint(quadrics, positions, n, m, candidate.cost);
+				candidate.keep = n;
+				candidate.remove = m;
+				candidate.keepStamp = stamps[n];
+				candidate.removeStamp = stamps[m];
+				queue.push(candidate);
+			}
+		}
+	}
+	std::vector<dvec3> kept;
+	for (int v = 0; v < N; ++v)
+	{
+		if (alive[v])kept.push_back(positions[v]);
+	}
+	return kept;
+}
+
+//Hull of the collapsed vertices, grown about its center until it holds every source vertex
+template <typename T>
+tShape<T> enclosingProxy(const tShape<T>& source, int targetCount, Arena* arena = nullptr)
+{
+	std::vector<dvec3> kept = collapseVertices(source, targetCount);
+	std::vector<tvec3<T>> points(kept.size());
+	for (size_t i = 0; i < kept.size(); ++i)
+	{
+		points[i] = tvec3<T>(kept[i]);
+	}
+	tShape<T> proxy = convexHull(points.data(), static_cast<int>(points.size()), arena);
+	if (proxy.count == 0)return proxy;
+	dvec3 center(proxy.getBounds().center);
+	double scale = 1.0;
+	for (int f = 0; f < proxy.faceCount; ++f)
+	{
+		dvec3 normal(proxy.faces[f]);
+		double height = dot(normal, dvec3(proxy.vertices[proxy.faceVerts[f].ind[0]]) - center);
+		if (height <= 0.0)continue;
+		for (int i = 0; i < source.count; ++i)
+		{
+			double reach = dot(normal, dvec3(source.vertices[i]) - center) / height;
+			if (reach > scale)scale = reach;
+		}
+	}
+	//Rounding T on the way back must not pull a face back inside a source vertex
+	scale *= 1.0 + 8.0 * std::numeric_limits<T>::epsilon();
+	for (int i = 0; i < proxy.count; ++i)
+	{
+		proxy.vertices[i] = tvec3<T>(center + (dvec3(proxy.vertices[i]) - center) * scale);
+	}
+	for (int f = 0; f < proxy.faceCount; ++f)
+	{
+		proxy.faceEdges[f].edge[0] = proxy.faceEdges[f].edge[0] * T(scale);
+		proxy.faceEdges[f].edge[1] = proxy.faceEdges[f].edge[1] * T(scale);
+	}
+	proxy.updateBounds();
+	return proxy;
+}
+
+//Whether the segment start + t * motion, t in [0, 1], enters a convex shape with outward unit face normals
+template <typename T>
+bool segmentHitsHull(const tvec3<T>& start, const tvec3<T>& motion, const tShape<T>& hull)
+{
+	T enter = T(0), exit = T(1);
+	for (int f = 0; f < hull.faceCount; ++f)
+	{
+		T distance = dot(hull.faces[f], start - hull.vertices[hull.faceVerts[f].ind[0]]);
+		T rate = dot(hull.faces[f], motion);
+		if (rate == T(0))
+		{
+			if (distance > T(0))return false;
+			continue;
+		}
+		T t = -distance / rate;
+		if (rate < T(0))enter = (t > enter) ? t : enter;
+		else exit = (t < exit) ? t : exit;
+		if (enter > exit)return false;
+	}
+	return true;
+}
+
+template <typename T>
+class tCollisionLods
+{
+public:
+	tCollisionLods()
+	{
+		//NULL
+	}
+	explicit tCollisionLods(const tShape<T>& source, int maximumLevels = 3, Arena* arena = nullptr)
+	{
+		build(source, maximumLevels, arena);
+	}
+	~tCollisionLods()
+	{
+		release();
+	}
+	tCollisionLods(const tCollisionLods&) = delete;
+	tCollisionLods& operator=(const tCollisionLods&) = delete;
+	//The source shape must outlive the chain, proxies are built from it rather than from each other
+	void build(const tShape<T>& source, int maximumLevels = 3, Arena* arena = nullptr)
+	{
+		release();
+		shape = &source;
+		std::vector<tShape<T>> built;
+		int previous = source.count;
+		for (int level = 0; level < maximumLevels; ++level)
+		{
+			int target = previous / reduction;
+			if (target < minimumCount)break;
+			tShape<T> proxy = enclosingProxy(source, target, arena);
+			if (proxy.count == 0 || proxy.count >= previous)break;
+			previous = proxy.count;
+			built.push_back(std::move(proxy));
+		}
+		proxyCount = static_cast<int>(built.size());
+		if (proxyCount == 0)return;
+		proxies = new tShape<T>[proxyCount];
+		for (int i = 0; i < proxyCount; ++i)
+		{
+			proxies[i] = std::move(built[i]);
+		}
+	}
+	//Includes the source shape as level 0
+	int getLevelCount() const
+	{
+		return proxyCount + 1;
+	}
+	const tShape<T>& getLevel(const int level) const
+	{
+		if (level == 0)return *shape;
+		return proxies[level - 1];
+	}
+	const tShape<T>& coarsest() const
+	{
+		return getLevel(proxyCount);
+	}
+	//Each level keeps about this fraction of the vertices of the one below
+	static const int reduction = 4;
+	//No proxy is built with fewer vertices than this
+	static const int minimumCount = 8;
+private:
+	void release()
+	{
+		if (proxies != nullptr)
+		{
+			delete[] proxies;
+			proxies = nullptr;
+		}
+		proxyCount = 0;
+	}
+	const tShape<T>* shape = nullptr;
+	tShape<T>* proxies = nullptr;
+	int proxyCount = 0;
+};
+
+typedef tCollisionLods<float> CollisionLods;
+
+//Coarse to fine ToI, each level starts from the time its enclosing level above made contact
+template <typename T>
+std::pair<T, T> gjkToI(const tCollisionLods<T>& A, const ttransform<T>& aTransform, const tCollisionLods<T>& B, const ttransform<T>& bTransform, const tvec3<T>& bVelocity, uint32_t* bisections = nullptr)
+{
+	std::pair<T, T> result(T(-1), T(-1));
+	ttransform<T> bStart = bTransform;
+	tvec3<T> step = bVelocity;
+	T elapsed = T(0);
+	uint32_t total = 0, used = 0;
+	//The finest bounds are the tightest, so they reject first
+	ttransform<T> relative = inverse(aTransform) * bTransform;
+	if (sweptBoundsMiss(A.getLevel(0).getBounds(), B.getLevel(0).getBounds(), relative, inverseTransformDirection(aTransform, bVelocity), T(0.01)))
+	{
+		if (bisections != nullptr)*bisections = 0;
+		return result;
+	}
+	int levels = (A.getLevelCount() > B.getLevelCount()) ? A.getLevelCount() : B.getLevelCount();
+	for (int level = levels - 1; level >= 0; --level)
+	{
+		const tShape<T>& a = A.getLevel((level < A.getLevelCount()) ? level : A.getLevelCount() - 1);
+		const tShape<T>& b = B.getLevel((level < B.getLevelCount()) ? level : B.getLevelCount() - 1);
+		//Proxies already overlapping at the start bound nothing, so refine without advancing
+		if (level > 0 && gjkDistance(a, aTransform, b, bStart) < T(0))continue;
+		result = gjkToI(a, aTransform, b, bStart, step, &used);
+		total += used;
+		if (result.first < T(0))break;
+		result.first = elapsed + (T(1) - elapsed) * result.first;
+		if (level == 0)break;
+		//Finer levels lie inside this one, so they cannot touch any earlier
+		T advance = result.first;
+		bStart.position = bTransform.position + bVelocity * advance;
+		step = bVelocity * (T(1) - advance);
+		elapsed = advance;
+	}
+	if (bisections != nullptr)*bisections = total;
+	return result;
+}
+
+#endif
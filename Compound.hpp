@@ -0,0 +1,428 @@
+/*
+Purpose: Approximate convex decomposition and compound shapes for concave meshes.
+	GJK only sees the convex hull of whatever it is given, so a concave mesh
+		is split into convex pieces and queried piece by piece.
+	The decomposition cuts the mesh's triangles, by centroid, with the axis
+		aligned plane that leaves the least concavity in the two halves, and
+		repeats on the most concave piece until every piece is within the
+		tolerance or the piece budget is spent.
+		A piece's concavity is how far its triangles (corners and centroids)
+		lie below the surface of the piece's convex hull.
+		Each piece is the hull of its triangles, so pieces can overlap a little
+		along cuts, in the manner of voxel based (VHACD style) decompositions.
+	A compound keeps its pieces under a binary tree of local boxes.
+		gjkDistance descends the tree nearest box first and skips any box
+		further from B's bounding sphere than the closest piece so far, then
+		stops at the first intersecting piece.
+		gjkWithinMargin and gjkIntersect walk the same tree and stop at the
+		first piece within the margin.
+		gjkToI works on compounds unchanged, it only calls those queries and
+		getBounds.
+	Either or both shapes of a query can be compounds.
+*/
+
+#ifndef __COMPOUND__
+#define __COMPOUND__
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "VectorMath.hpp"
+#include "Shape.hpp"
+#include "Hull.hpp"
+#include "GJK.hpp"
+
+template <typename T>
+struct tCompoundNode
+{
+	tvec3<T> minimum, maximum;
+	int left = -1, right = -1;//children, both -1 on a leaf
+	int piece = -1;//leaf piece index
+};
+
+template <typename T>
+class tCompoundShape
+{
+public:
+	tCompoundShape()
+	{
+		//NULL
+	}
+	~tCompoundShape()
+	{
+		release();
+	}
+	tCompoundShape(const tCompoundShape&) = delete;
+	tCompoundShape& operator=(const tCompoundShape&) = delete;
+	tCompoundShape(tCompoundShape&& mv) noexcept
+	{
+		swap(mv);
+	}
+	tCompoundShape& operator=(tCompoundShape&& mv) noexcept
+	{
+		swap(mv);
+		return *this;
+	}
+	//Takes ownership of the pieces and builds the tree over them
+	void build(std::vector<tShape<T>>& parts)
+	{
+		release();
+		pieceCount = static_cast<int>(parts.size());
+		if (pieceCount == 0)return;
+		pieces = new tShape<T>[pieceCount];
+		std::vector<tvec3<T>> points;
+		for (int i = 0; i < pieceCount; ++i)
+		{
+			pieces[i] = std::move(parts[i]);
+			points.push_back(pieces[i].getBounds().minimum);
+			points.push_back(pieces[i].getBounds().maximum);
+		}
+		parts.clear();
+		bounds = computeBounds(points.data(), static_cast<int>(points.size()));
+		//The sphere must hold every piece's vertices, not only the corners of their boxes
+		T radiusSq = T(0);
+		for (int i = 0; i < pieceCount; ++i)
+		{
+			for (int j = 0; j < pieces[i].count; ++j)
+			{
+				tvec3<T> offset = pieces[i].vertices[j] - bounds.center;
+				radiusSq = std::fmax(radiusSq, dot(offset, offset));
+			}
+		}
+		bounds.radius = std::sqrt(radiusSq);
+		nodes = new tCompoundNode<T>[2 * pieceCount - 1];
+		nodeCount = 0;
+		std::vector<int> order(pieceCount);
+		for (int i = 0; i < pieceCount; ++i)
+		{
+			order[i] = i;
+		}
+		buildNode(order.data(), pieceCount);
+	}
+	const tBounds<T>& getBounds() const
+	{
+		return bounds;
+	}
+	int pieceCount = 0;
+	tShape<T>* pieces = nullptr;
+	//Node 0 is the root
+	int nodeCount = 0;
+	tCompoundNode<T>* nodes = nullptr;
+	//Deep enough for a tree over far more pieces than any decomposition produces
+	static const int maximumDepth = 64;
+private:
+	//Median split of the piece boxes' centers along the longest axis
+	int buildNode(int* order, int N)
+	{
+		int index = nodeCount++;
+		tCompoundNode<T>& node = nodes[index];
+		node.minimum = pieces[order[0]].getBounds().minimum;
+		node.maximum = pieces[order[0]].getBounds().maximum;
+		for (int i = 1; i < N; ++i)
+		{
+			const tBounds<T>& b = pieces[order[i]].getBounds();
+			node.minimum = tvec3<T>(std::fmin(node.minimum.x, b.minimum.x), std::fmin(node.minimum.y, b.minimum.y), std::fmin(node.minimum.z, b.minimum.z));
+			node.maximum = tvec3<T>(std::fmax(node.maximum.x, b.maximum.x), std::fmax(node.maximum.y, b.maximum.y), std::fmax(node.maximum.z, b.maximum.z));
+		}
+		if (N == 1)
+		{
+			node.piece = order[0];
+			return index;
+		}
+		tvec3<T> extent = node.maximum - node.minimum;
+		int axis = (extent.x >= extent.y) ? ((extent.x >= extent.z) ? 0 : 2) : ((extent.y >= extent.z) ? 1 : 2);
+		std::vector<std::pair<T, int>> centers(N);
+		for (int i = 0; i < N; ++i)
+		{
+			const tBounds<T>& b = pieces[order[i]].getBounds();
+			const T center[3] = { b.minimum.x + b.maximum.x, b.minimum.y + b.maximum.y, b.minimum.z + b.maximum.z };
+			centers[i] = std::make_pair(center[axis], order[i]);
+		}
+		std::nth_element(centers.begin(), centers.begin() + N / 2, centers.end());
+		for (int i = 0; i < N; ++i)
+		{
+			order[i] = centers[i].second;
+		}
+		int left = buildNode(order, N / 2);
+		int right = buildNode(order + N / 2, N - N / 2);
+		nodes[index].left = left;
+		nodes[index].right = right;
+		return index;
+	}
+	void release()
+	{
+		if (pieces != nullptr)
+		{
+			delete[] pieces;
+			pieces = nullptr;
+		}
+		if (nodes != nullptr)
+		{
+			delete[] nodes;
+			nodes = nullptr;
+		}
+		pieceCount = 0;
+		nodeCount = 0;
+	}
+	void swap(tCompoundShape& other)
+	{
+		std::swap(pieceCount, other.pieceCount);
+		std::swap(pieces, other.pieces);
+		std::swap(nodeCount, other.nodeCount);
+		std::swap(nodes, other.nodes);
+		std::swap(bounds, other.bounds);
+	}
+	tBounds<T> bounds;
+};
+
+typedef tCompoundShape<float> CompoundShape;
+
+//Squared distance from a point to a box, 0 inside
+template <typename T>
+T boxPointDistanceSq(const tvec3<T>& minimum, const tvec3<T>& maximum, const tvec3<T>& p)
+{
+	T dx = std::fmax(std::fmax(minimum.x - p.x, p.x - maximum.x), T(0));
+	T dy = std::fmax(std::fmax(minimum.y - p.y, p.y - maximum.y), T(0));
+	T dz = std::fmax(std::fmax(minimum.z - p.z, p.z - maximum.z), T(0));
+	return dx * dx + dy * dy + dz * dz;
+}
+
+//Closest piece of A to B, -1 as soon as any piece intersects
+//	As with shapes, a result above cullDistance is only a lower bound
+template <typename T, typename ShapeB>
+T compoundDistance(const tCompoundShape<T>& A, const ShapeB& B, const ttransform<T>& bRelative, uint32_t* iterations, const T cullDistance)
+{
+	const tBounds<T>& bBounds = B.getBounds();
+	tvec3<T> bCenter = transformPoint(bRelative, bBounds.center);
+	T best = std::numeric_limits<T>::max();
+	uint32_t total = 0, used = 0;
+	int stack[tCompoundShape<T>::maximumDepth];
+	int top = 0;
+	if (A.nodeCount > 0)stack[top++] = 0;
+	while (top > 0)
+	{
+		const tCompoundNode<T>& node = A.nodes[stack[--top]];
+		T gap = std::sqrt(boxPointDistanceSq(node.minimum, node.maximum, bCenter)) - bBounds.radius;
+		if (gap >= best)continue;
+		if (gap > cullDistance)
+		{
+			best = gap;
+			continue;
+		}
+		if (node.piece >= 0)
+		{
+			T distance = gjkDistance(A.pieces[node.piece], B, bRelative, &used, (best < cullDistance) ? best : cullDistance);
+			total += used;
+			if (distance < T(0))
+			{
+				best = distance;
+				break;
+			}
+			if (distance < best)best = distance;
+			continue;
+		}
+		//Nearer child on top of the stack
+		const tCompoundNode<T>& left = A.nodes[node.left];
+		const tCompoundNode<T>& right = A.nodes[node.right];
+		bool leftFirst = boxPointDistanceSq(left.minimum, left.maximum, bCenter) <= boxPointDistanceSq(right.minimum, right.maximum, bCenter);
+		stack[top++] = leftFirst ? node.right : node.left;
+		stack[top++] = leftFirst ? node.left : node.right;
+	}
+	if (iterations != nullptr)*iterations = total;
+	return best;
+}
+
+template <typename T, typename ShapeB>
+T gjkDistance(const tCompoundShape<T>& A, const ShapeB& B, const ttransform<T>& bRelative, uint32_t* iterations = nullptr, const T cullDistance = std::numeric_limits<T>::max())
+{
+	return compoundDistance(A, B, bRelative, iterations, cullDistance);
+}
+
+template <typename T, typename ShapeA>
+T gjkDistance(const ShapeA& A, const tCompoundShape<T>& B, const ttransform<T>& bRelative, uint32_t* iterations = nullptr, const T cullDistance = std::numeric_limits<T>::max())
+{
+	return gjkDistance(B, A, inverse(bRelative), iterations, cullDistance);
+}
+
+//Each of A's pieces reached in the tree descends B's tree in turn
+template <typename T>
+T gjkDistance(const tCompoundShape<T>& A, const tCompoundShape<T>& B, const ttransform<T>& bRelative, uint32_t* iterations = nullptr, const T cullDistance = std::numeric_limits<T>::max())
+{
+	return compoundDistance(A, B, bRelative, iterations, cullDistance);
+}
+
+//Whether any piece of A comes within margin of B, the first piece that does ends the walk
+template <typename T, typename ShapeB>
+bool compoundWithinMargin(const tCompoundShape<T>& A, const ShapeB& B, const ttransform<T>& bRelative, const T margin, uint32_t* iterations)
+{
+	const tBounds<T>& bBounds = B.getBounds();
+	tvec3<T> bCenter = transformPoint(bRelative, bBounds.center);
+	T reach = bBounds.radius + margin;
+	bool within = false;
+	uint32_t total = 0, used = 0;
+	int stack[tCompoundShape<T>::maximumDepth];
+	int top = 0;
+	if (A.nodeCount > 0)stack[top++] = 0;
+	while (top > 0 && !within)
+	{
+		const tCompoundNode<T>& node = A.nodes[stack[--top]];
+		if (boxPointDistanceSq(node.minimum, node.maximum, bCenter) > reach * reach)continue;
+		if (node.piece >= 0)
+		{
+			within = gjkWithinMargin(A.pieces[node.piece], B, bRelative, margin, &used);
+			total += used;
+			continue;
+		}
+		const tCompoundNode<T>& left = A.nodes[node.left];
+		const tCompoundNode<T>& right = A.nodes[node.right];
+		bool leftFirst = boxPointDistanceSq(left.minimum, left.maximum, bCenter) <= boxPointDistanceSq(right.minimum, right.maximum, bCenter);
+		stack[top++] = leftFirst ? node.right : node.left;
+		stack[top++] = leftFirst ? node.left : node.right;
+	}
+	if (iterations != nullptr)*iterations = total;
+	return within;
+}
+
+template <typename T, typename ShapeB>
+bool gjkWithinMargin(const tCompoundShape<T>& A, const ShapeB& B, const ttransform<T>& bRelative, const T margin, uint32_t* iterations = nullptr)
+{
+	return compoundWithinMargin(A, B, bRelative, margin, iterations);
+}
+
+template <typename T, typename ShapeA>
+bool gjkWithinMargin(const ShapeA& A, const tCompoundShape<T>& B, const ttransform<T>& bRelative, const T margin, uint32_t* iterations = nullptr)
+{
+	return gjkWithinMargin(B, A, inverse(bRelative), margin, iterations);
+}
+
+template <typename T>
+bool gjkWithinMargin(const tCompoundShape<T>& A, const tCompoundShape<T>& B, const ttransform<T>& bRelative, const T margin, uint32_t* iterations = nullptr)
+{
+	return compoundWithinMargin(A, B, bRelative, margin, iterations);
+}
+
+//Deepest any triangle corner or centroid of the piece lies below its hull's surface, the hull is returned through hull
+template <typename T>
+T pieceConcavity(const tShape<T>& mesh, const std::vector<int>& triangles, tShape<T>& hull)
+{
+	std::vector<char> used(mesh.count, 0);
+	std::vector<tvec3<T>> points;
+	for (int f : triangles)
+	{
+		for (int k = 0; k < 3; ++k)
+		{
+			int v = mesh.faceVerts[f].ind[k];
+			if (used[v])continue;
+			used[v] = 1;
+			points.push_back(mesh.vertices[v]);
+		}
+	}
+	hull = convexHull(points.data(), static_cast<int>(points.size()));
+	if (hull.count == 0)return std::numeric_limits<T>::max();
+	T deepest = T(0);
+	for (int f : triangles)
+	{
+		const Indices3& face = mesh.faceVerts[f];
+		tvec3<T> samples[4] = { mesh.vertices[face.ind[0]], mesh.vertices[face.ind[1]], mesh.vertices[face.ind[2]],
+			(mesh.vertices[face.ind[0]] + mesh.vertices[face.ind[1]] + mesh.vertices[face.ind[2]]) * (T(1) / T(3)) };
+		for (const tvec3<T>& p : samples)
+		{
+			T depth = std::numeric_limits<T>::max();
+			for (int h = 0; h < hull.faceCount; ++h)
+			{
+				T below = dot(hull.faces[h], hull.vertices[hull.faceVerts[h].ind[0]] - p);
+				if (below < depth)depth = below;
+			}
+			if (depth > deepest)deepest = depth;
+		}
+	}
+	return deepest;
+}
+
+//Splits a mesh into at most maximumPieces convex pieces, stopping once every piece is within tolerance * (bounding radius) of its hull
+template <typename T>
+tCompoundShape<T> convexDecomposition(const tShape<T>& mesh, const T tolerance = T(0.05), const int maximumPieces = 16)
+{
+	struct Piece
+	{
+		std::vector<int> triangles;
+		tShape<T> hull;
+		T concavity;
+	};
+	const T limit = tolerance * mesh.getBounds().radius;
+	std::vector<Piece> pieces(1);
+	for (int f = 0; f < mesh.faceCount; ++f)
+	{
+		pieces[0].triangles.push_back(f);
+	}
+	pieces[0].concavity = pieceConcavity(mesh, pieces[0].triangles, pieces[0].hull);
+	std::vector<T> centroids(3 * mesh.faceCount);
+	for (int f = 0; f < mesh.faceCount; ++f)
+	{
+		const Indices3& face = mesh.faceVerts[f];
+		tvec3<T> c = mesh.vertices[face.ind[0]] + mesh.vertices[face.ind[1]] + mesh.vertices[face.ind[2]];
+		centroids[3 * f] = c.x;
+		centroids[3 * f + 1] = c.y;
+		centroids[3 * f + 2] = c.z;
+	}
+	while (static_cast<int>(pieces.size()) < maximumPieces)
+	{
+		int worst = 0;
+		for (int i = 1; i < static_cast<int>(pieces.size()); ++i)
+		{
+			if (pieces[i].concavity > pieces[worst].concavity)worst = i;
+		}
+		if (pieces[worst].concavity <= limit)break;
+		//Candidate cuts at the quartiles of the triangle centroids on each axis
+		const std::vector<int>& triangles = pieces[worst].triangles;
+		if (triangles.size() < 2)break;
+		Piece bestLow, bestHigh;
+		T bestCost = std::numeric_limits<T>::max();
+		std::vector<T> values(triangles.size());
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			for (size_t i = 0; i < triangles.size(); ++i)
+			{
+				values[i] = centroids[3 * triangles[i] + axis];
+			}
+			std::vector<T> sorted(values);
+			std::sort(sorted.begin(), sorted.end());
+			for (int quartile = 1; quartile <= 3; ++quartile)
+			{
+				T cut = sorted[(sorted.size() * quartile) / 4];
+				Piece low, high;
+				for (size_t i = 0; i < triangles.size(); ++i)
+				{
+					if (values[i] < cut)low.triangles.push_back(triangles[i]);
+					else high.triangles.push_back(triangles[i]);
+				}
+				if (low.triangles.empty() || high.triangles.empty())continue;
+				low.concavity = pieceConcavity(mesh, low.triangles, low.hull);
+				high.concavity = pieceConcavity(mesh, high.triangles, high.hull);
+				T cost = low.concavity + high.concavity;
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestLow = std::move(low);
+					bestHigh = std::move(high);
+				}
+			}
+		}
+		if (bestCost == std::numeric_limits<T>::max())break;
+		pieces[worst] = std::move(bestLow);
+		pieces.push_back(std::move(bestHigh));
+	}
+	std::vector<tShape<T>> parts;
+	for (Piece& piece : pieces)
+	{
+		parts.push_back(std::move(piece.hull));
+	}
+	tCompoundShape<T> compound;
+	compound.build(parts);
+	return compound;
+}
+
+#endif
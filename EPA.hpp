@@ -0,0 +1,390 @@
+/*
+Purpose: Penetration depth, contact normal and witness points of intersecting
+		convex shapes with the Expanding Polytope Algorithm.
+	GJK stops once its simplex encloses the origin, which only says the shapes
+		overlap. EPA grows that simplex into a polytope inside B - A, always
+		pushing out the face nearest the origin with a support point along
+		its normal, until the support point adds nothing and that face is on
+		the surface of B - A.
+		The face's distance is the penetration depth, its normal the direction
+		B moves to separate, and the face's barycentric weights over the
+		support points kept on A and on B are the witness points.
+	A simplex that only touches the origin (a vertex, edge or triangle) is
+		first blown up to a tetrahedron with extra support points.
+	Vertices, faces and the horizon of each step live in a tPolytope whose
+		buffers are allocated once, so a query never touches the heap.
+		The faces visible from a new support point are found by walking out
+			from the nearest face, and the edges where the walk stops are the
+			horizon that the new faces fan from.
+		Each face keeps the face across each of its edges, so the walk and
+			the new faces' links cost nothing per step beyond the faces touched.
+		Callers may keep their own per thread, otherwise each thread reuses
+		one made on its first query.
+		A query that runs out of room returns the best face found so far.
+	As with gjkDistance, the query is solved in A's frame.
+*/
+
+#ifndef __EPA__
+#define __EPA__
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include "VectorMath.hpp"
+#include "Shape.hpp"
+#include "GJK.hpp"
+
+template <typename T>
+struct tPenetration
+{
+	//Overlap along normal, or minus the distance when the shapes are apart
+	T depth = 0;
+	//Unit direction, in A's frame, that B moves by depth to separate
+	tvec3<T> normal;
+	//Deepest points on A and on B, in A's frame, pointB - pointA is normal * -depth
+	tvec3<T> pointA, pointB;
+	uint32_t iterations = 0;
+};
+
+typedef tPenetration<float> Penetration;
+
+template <typename T>
+struct tPolytopeVertex
+{
+	tvec3<T> w;//point of B - A
+	tvec3<T> a, b;//support points on A and on B
+};
+
+template <typename T>
+struct tPolytopeFace
+{
+	uint32_t v[3];
+	int neighbor[3];//face across the edge v[i] to v[(i + 1) % 3]
+	tvec3<T> normal;//outward, unit
+	T distance;//from the origin along normal
+};
+
+template <typename T>
+class tPolytope
+{
+public:
+	explicit tPolytope(const uint32_t vertexCapacity_ = 128)
+	{
+		vertexCapacity = vertexCapacity_;
+		//A closed triangulated polytope of V vertices has 2V - 4 faces, each removed face gives at most 3 horizon edges
+		faceCapacity = 2 * vertexCapacity;
+		edgeCapacity = 3 * faceCapacity;
+		vertices = new tPolytopeVertex<T>[vertexCapacity];
+		faces = new tPolytopeFace<T>[faceCapacity];
+		edges = new uint32_t[3 * edgeCapacity];
+		pending = new uint32_t[faceCapacity];
+		seen = new bool[faceCapacity];
+		horizonStart = new uint32_t[vertexCapacity];
+	}
+	~tPolytope()
+	{
+		delete[] vertices;
+		delete[] faces;
+		delete[] edges;
+		delete[] pending;
+		delete[] seen;
+		delete[] horizonStart;
+	}
+	tPolytope(const tPolytope&) = delete;
+	tPolytope& operator=(const tPolytope&) = delete;
+	void clear()
+	{
+		vertexCount = faceCount = edgeCount = 0;
+	}
+	uint32_t addVertex(const tPolytopeVertex<T>& vertex)
+	{
+		vertices[vertexCount] = vertex;
+		return vertexCount++;
+	}
+	//Face a, b, c wound counter clockwise seen from outside, its neighbors are left for the caller to link
+	uint32_t addFace(const uint32_t a, const uint32_t b, const uint32_t c)
+	{
+		seen[faceCount] = false;
+		tPolytopeFace<T>& face = faces[faceCount];
+		face.v[0] = a;
+		face.v[1] = b;
+		face.v[2] = c;
+		face.neighbor[0] = face.neighbor[1] = face.neighbor[2] = -1;
+		tvec3<T> n = cross(vertices[b].w - vertices[a].w, vertices[c].w - vertices[a].w);
+		T length = std::sqrt(dot(n, n));
+		//A sliver has no direction to push out along, so it is never chosen
+		if (length > T(0))
+		{
+			face.normal = n / length;
+			face.distance = dot(face.normal, vertices[a].w);
+		}
+		else
+		{
+			face.normal = tvec3<T>(0.0f, 0.0f, 0.0f);
+			face.distance = std::numeric_limits<T>::max();
+		}
+		return faceCount++;
+	}
+	//Points face's side of the edge b to a at across
+	void linkAcross(const uint32_t face, const uint32_t a, const uint32_t b, const int across)
+	{
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			if (faces[face].v[k] == b && faces[face].v[(k + 1) % 3] == a)faces[face].neighbor[k] = across;
+		}
+	}
+	//The last face fills the hole, and its neighbors are pointed at its new index
+	void removeFace(const uint32_t index)
+	{
+		uint32_t last = --faceCount;
+		if (index == last)return;
+		faces[index] = faces[last];
+		seen[index] = seen[last];
+		for (uint32_t k = 0; k < 3; ++k)
+		{
+			int n = faces[index].neighbor[k];
+			if (n < 0)continue;
+			for (uint32_t j = 0; j < 3; ++j)
+			{
+				if (faces[n].neighbor[j] == static_cast<int>(last))faces[n].neighbor[j] = static_cast<int>(index);
+			}
+		}
+	}
+	//Horizon edge a to b, across is the face behind it that stays
+	void addEdge(const uint32_t a, const uint32_t b, const int across)
+	{
+		edges[3 * edgeCount] = a;
+		edges[3 * edgeCount + 1] = b;
+		edges[3 * edgeCount + 2] = static_cast<uint32_t>(across);
+		++edgeCount;
+	}
+	uint32_t vertexCapacity = 0, faceCapacity = 0, edgeCapacity = 0;
+	uint32_t vertexCount = 0, faceCount = 0, edgeCount = 0;
+	tPolytopeVertex<T>* vertices = nullptr;
+	tPolytopeFace<T>* faces = nullptr;
+	uint32_t* edges = nullptr;
+	//Faces waiting to be walked and faces already reached while finding the horizon
+	uint32_t* pending = nullptr;
+	bool* seen = nullptr;
+	//New face whose horizon edge starts at each vertex, used to link the cone of new faces
+	uint32_t* horizonStart = nullptr;
+};
+
+typedef tPolytope<float> Polytope;
+
+//Adds support points until GJK's final simplex is a tetrahedron, false when B - A is flat there
+template <typename T, typename ShapeA, typename ShapeB>
+bool expandSimplex(const ShapeA& A, const ShapeB& B, const tmat3<T>& bRotation, const tvec3<T>& bOffset, tsimplex<T>& S, uint32_t& supportA, uint32_t& supportB)
+{
+	const T flat = std::numeric_limits<T>::epsilon() * T(1024);
+	const tvec3<T> axes[3] = { tvec3<T>(1.0f, 0.0f, 0.0f), tvec3<T>(0.0f, 1.0f, 0.0f), tvec3<T>(0.0f, 0.0f, 1.0f) };
+	if (S.count == 1)
+	{
+		for (uint32_t i = 0; i < 6 && S.count == 1; ++i)
+		{
+			tvec3<T> D = (i & 1) ? T(-1) * axes[i >> 1] : axes[i >> 1];
+			tPolytopeVertex<T> vertex;
+			vertex.w = minkowskiSupport(A, B, bRotation, bOffset, D, supportA, supportB, vertex.a, vertex.b);
+			tvec3<T> offset = vertex.w - S.verts[0];
+			if (dot(offset, offset) <= flat)continue;
+			S.verts[1] = vertex.w;
+			S.aPoints[1] = vertex.a;
+			S.bPoints[1] = vertex.b;
+			S.count = 2;
+		}
+	}
+	if (S.count == 2)
+	{
+		//Around the segment, starting from the axis least aligned with it
+		tvec3<T> segment = S.verts[1] - S.verts[0];
+		T sx = std::abs(segment.x), sy = std::abs(segment.y), sz = std::abs(segment.z);
+		const tvec3<T>& least = (sx <= sy && sx <= sz) ? axes[0] : ((sy <= sz) ? axes[1] : axes[2]);
+		tvec3<T> first = cross(segment, least);
+		tvec3<T> directions[4] = { first, cross(segment, first), T(-1) * first, T(-1) * cross(segment, first) };
+		for (uint32_t i = 0; i < 4 && S.count == 2; ++i)
+		{
+			tPolytopeVertex<T> vertex;
+			vertex.w = minkowskiSupport(A, B, bRotation, bOffset, directions[i], supportA, supportB, vertex.a, vertex.b);
+			tvec3<T> away = cross(vertex.w - S.verts[0], segment);
+			if (dot(away, away) <= flat * dot(segment, segment))continue;
+			S.verts[2] = vertex.w;
+			S.aPoints[2] = vertex.a;
+			S.bPoints[2] = vertex.b;
+			S.count = 3;
+		}
+	}
+	if (S.count == 3)
+	{
+		tvec3<T> n = cross(S.verts[1] - S.verts[0], S.verts[2] - S.verts[0]);
+		for (uint32_t i = 0; i < 2 && S.count == 3; ++i)
+		{
+			tPolytopeVertex<T> vertex;
+			vertex.w = minkowskiSupport(A, B, bRotation, bOffset, (i == 0) ? n : T(-1) * n, supportA, supportB, vertex.a, vertex.b);
+			T height = dot(vertex.w - S.verts[0], n);
+			if (height * height <= flat * dot(n, n))continue;
+			S.verts[3] = vertex.w;
+			S.aPoints[3] = vertex.a;
+			S.bPoints[3] = vertex.b;
+			S.count = 4;
+		}
+	}
+	return S.count == 4;
+}
+
+//Witness points from the weights of the origin's projection onto face
+template <typename T>
+void facePenetration(const tPolytope<T>& polytope, const tPolytopeFace<T>& face, tPenetration<T>& result)
+{
+	const tPolytopeVertex<T>& a = polytope.vertices[face.v[0]];
+	const tPolytopeVertex<T>& b = polytope.vertices[face.v[1]];
+	const tPolytopeVertex<T>& c = polytope.vertices[face.v[2]];
+	tvec3<T> weights = barycentricCoordinates(face.normal * face.distance, a.w, b.w, c.w);
+	result.depth = face.distance;
+	result.normal = T(-1) * face.normal;
+	result.pointA = a.a * weights.x + b.a * weights.y + c.a * weights.z;
+	result.pointB = a.b * weights.x + b.b * weights.y + c.b * weights.z;
+}
+
+//Fills result and returns true when A and B intersect, otherwise result.depth is minus their distance
+template <typename T, typename ShapeA, typename ShapeB>
+bool gjkPenetration(const ShapeA& A, const ShapeB& B, const ttransform<T>& bRelative, tPenetration<T>& result, tPolytope<T>& polytope)
+{
+	tmat3<T> bRotation = toMat3(bRelative.orientation);
+	const tvec3<T>& bOffset = bRelative.position;
+	tsimplex<T> S;
+	tvec3<T> closest;
+	uint32_t itr = 0;
+	result.iterations = 0;
+	if (!gjkSolve(A, B, bRotation, bOffset, S, closest, itr))
+	{
+		result.depth = -std::sqrt(dot(closest, closest));
+		result.iterations = itr;
+		return false;
+	}
+	uint32_t supportA = S.aID[0], supportB = S.bID[0];
+	if (!expandSimplex(A, B, bRotation, bOffset, S, supportA, supportB))
+	{
+		//Touching along a flat patch of B - A, the contact has no depth
+		result.depth = T(0);
+		result.normal = tvec3<T>(0.0f, 0.0f, 0.0f);
+		result.pointA = S.aPoints[0];
+		result.pointB = S.bPoints[0];
+		result.iterations = itr;
+		return true;
+	}
+	polytope.clear();
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		tPolytopeVertex<T> vertex;
+		vertex.w = S.verts[i];
+		vertex.a = S.aPoints[i];
+		vertex.b = S.bPoints[i];
+		polytope.addVertex(vertex);
+	}
+	//Each face wound so the remaining vertex is behind it
+	const uint32_t tetrahedron[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		const uint32_t* f = tetrahedron[i];
+		tvec3<T> n = cross(S.verts[f[1]] - S.verts[f[0]], S.verts[f[2]] - S.verts[f[0]]);
+		if (dot(n, S.verts[f[3]] - S.verts[f[0]]) > T(0))polytope.addFace(f[0], f[2], f[1]);
+		else polytope.addFace(f[0], f[1], f[2]);
+	}
+	//Any two faces of a tetrahedron share an edge, the only time neighbors are searched for
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		for (uint32_t j = 0; j < 4; ++j)
+		{
+			if (i != j)polytope.linkAcross(j, polytope.faces[i].v[0], polytope.faces[i].v[1], static_cast<int>(i));
+			if (i != j)polytope.linkAcross(j, polytope.faces[i].v[1], polytope.faces[i].v[2], static_cast<int>(i));
+			if (i != j)polytope.linkAcross(j, polytope.faces[i].v[2], polytope.faces[i].v[0], static_cast<int>(i));
+		}
+	}
+	const T tolerance = std::numeric_limits<T>::epsilon() * T(1024);
+	tPolytopeFace<T> best = polytope.faces[0];
+	while (true)
+	{
+		++itr;
+		uint32_t nearest = 0;
+		for (uint32_t i = 1; i < polytope.faceCount; ++i)
+		{
+			if (polytope.faces[i].distance < polytope.faces[nearest].distance)nearest = i;
+		}
+		best = polytope.faces[nearest];
+		tPolytopeVertex<T> vertex;
+		vertex.w = minkowskiSupport(A, B, bRotation, bOffset, best.normal, supportA, supportB, vertex.a, vertex.b);
+		//The nearest face is on the surface of B - A
+		if (dot(vertex.w, best.normal) - best.distance <= tolerance * (T(1) + best.distance))break;
+		if (polytope.vertexCount == polytope.vertexCapacity)break;
+		uint32_t added = polytope.addVertex(vertex);
+		//Visible faces are walked out from the nearest one, so a face only marginally visible
+		//	across the polytope cannot split the hole and leave faces overlapping
+		polytope.edgeCount = 0;
+		uint32_t pendingCount = 0;
+		polytope.pending[pendingCount++] = nearest;
+		polytope.seen[nearest] = true;
+		while (pendingCount > 0)
+		{
+			uint32_t current = polytope.pending[--pendingCount];
+			for (uint32_t k = 0; k < 3; ++k)
+			{
+				int across = polytope.faces[current].neighbor[k];
+				if (across >= 0 && polytope.seen[across])continue;
+				if (across >= 0)
+				{
+					const tPolytopeFace<T>& face = polytope.faces[across];
+					if (dot(face.normal, vertex.w - polytope.vertices[face.v[0]].w) > T(0))
+					{
+						polytope.seen[across] = true;
+						polytope.pending[pendingCount++] = static_cast<uint32_t>(across);
+						continue;
+					}
+				}
+				polytope.addEdge(polytope.faces[current].v[k], polytope.faces[current].v[(k + 1) % 3], across);
+			}
+		}
+		//Out of room, the polytope is left as it was and the last nearest face stands
+		if (polytope.faceCount + polytope.edgeCount > polytope.faceCapacity)break;
+		//Cone of new faces from the horizon to the new vertex, linked to the faces behind the horizon and to each other
+		uint32_t firstAdded = polytope.faceCount;
+		for (uint32_t i = 0; i < polytope.edgeCount; ++i)
+		{
+			uint32_t a = polytope.edges[3 * i], b = polytope.edges[3 * i + 1];
+			int across = static_cast<int>(polytope.edges[3 * i + 2]);
+			uint32_t face = polytope.addFace(a, b, added);
+			polytope.faces[face].neighbor[0] = across;
+			if (across >= 0)polytope.linkAcross(static_cast<uint32_t>(across), a, b, static_cast<int>(face));
+			polytope.horizonStart[a] = face;
+		}
+		for (uint32_t face = firstAdded; face < polytope.faceCount; ++face)
+		{
+			//Edge (b, added) meets the face starting at b, edge (added, a) meets the face ending at a
+			uint32_t next = polytope.horizonStart[polytope.faces[face].v[1]];
+			polytope.faces[face].neighbor[1] = static_cast<int>(next);
+			polytope.faces[next].neighbor[2] = static_cast<int>(face);
+		}
+		for (uint32_t i = firstAdded; i-- > 0;)
+		{
+			if (polytope.seen[i])polytope.removeFace(i);
+		}
+	}
+	facePenetration(polytope, best, result);
+	result.iterations = itr;
+	return true;
+}
+
+//Each thread reuses one polytope, allocated on its first query
+template <typename T, typename ShapeA, typename ShapeB>
+bool gjkPenetration(const ShapeA& A, const ShapeB& B, const ttransform<T>& bRelative, tPenetration<T>& result)
+{
+	static thread_local tPolytope<T> polytope;
+	return gjkPenetration(A, B, bRelative, result, polytope);
+}
+
+template <typename T, typename ShapeA, typename ShapeB>
+bool gjkPenetration(const ShapeA& A, const ShapeB& B, const tvec3<T>& bOffset, tPenetration<T>& result)
+{
+	return gjkPenetration(A, B, ttransform<T>(bOffset), result);
+}
+
+#endif
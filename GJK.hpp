@@ -3,19 +3,44 @@ Author: Dan Rehberg
 Date Modified: 8/5/2020
 
 Purpose: This is a 3D implementation of the distance GJK algorithm.
-	It does not include the case of orientation changes.
-	Note, if anyone wishes to reused this, feel free to exchange the 
-		translation only information for the Minkowski Difference to
-		use 4x4 matrics for linear and rotational changes, or to combine
-		quaternions and translations separately to limit floating point
-		operations.
+	Orientation changes are handled with a rigid transform (quaternion and
+		translation) per shape.
+		The query is solved in the frame of Shape A, so only B needs a
+		relative transform, and the search direction is rotated into B's
+		local frame rather than rotating each of B's vertices.
+		The translation only overloads are kept for the original trials.
+	Shapes are template parameters, any type with the supportVertex member
+		of tShape can be used, e.g. tQuantizedShape or the implicit shapes.
+		Support queries are seeded with the previous iteration's support
+			points, which lets large convex meshes hill climb a few vertices
+			instead of scanning all of them.
+		The scalar type is taken from the transform or offset argument.
 	Additionally, there might be redundancies in this implementation for
 		testing out cases.
 		The distance version of GJK is a little finnicky with exit conditions
 			in 3D (compared to the boolean version of the algorithm).
 		So, feel free to verify the conditions and alter them as best fits.
-	Moreover, this build does not always function correctly.
-		It might conservately assume a separation too often.
+	Every shape also provides getBounds(), a cached local box and bounding sphere.
+		gjkDistance takes an optional cullDistance and returns the gap between
+			bounding spheres, without iterating, for pairs further apart.
+		gjkToI returns no impact, without bisecting, when B's bounding sphere
+			swept over the step never reaches A's.
+	gjkIntersect and gjkWithinMargin answer yes or no queries, ending on the
+		first separating axis or enclosing simplex instead of converging, and
+		gjkToI uses them for the bisection steps that stay clear of A.
+	Implicit shapes report noFeatureID instead of a vertex index, so their
+		queries end on lack of progress toward the origin rather than on a
+		repeated support point.
+	The simplex is reduced with signed volumes (see simplexMin), which give the
+		closest point, its barycentric weights and the smallest sub-simplex
+		holding it in one pass, so no closest point is recomputed per
+		iteration and flat tetrahedra no longer cycle into early exits.
+	The loop itself is gjkSolve, which leaves the final simplex (with the
+		support points on A and B of each vertex) for EPA.hpp to continue from.
+		gjkClosestPoints returns that simplex's closest points on A and B,
+		from its barycentric weights, and its support ids as the features.
+		A closest point within rounding of the origin, at the simplex's scale,
+		counts as touching.
 	Note, if this is reused, consider building a better Shape class as the 
 		one for this program is capped in its mesh complexity.
 */
@@ -23,213 +48,552 @@ Purpose: This is a 3D implementation of the distance GJK algorithm.
 #ifndef __DISTANCE_GJK__
 #define __DISTANCE_GJK__
 
+#include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <utility>
 #include "VectorMath.hpp"
 #include "Shape.hpp"
 
-struct simplex
+template <typename T>
+struct tsimplex
 {
-	vec3 verts[4];//should initialze to zero vectors... see above
-	int aID[4] = { 0, 0, 0, 0 };
-	int bID[4] = { 0, 0, 0, 0 };
+	tvec3<T> verts[4];//should initialze to zero vectors... see above
+	uint32_t aID[4] = { 0, 0, 0, 0 };
+	uint32_t bID[4] = { 0, 0, 0, 0 };
+	//Support points on A and on B (in A's frame) whose difference is each vertex
+	tvec3<T> aPoints[4];
+	tvec3<T> bPoints[4];
+	//Barycentric weights of the closest point, written by simplexMin
+	T weights[4] = { 0, 0, 0, 0 };
 	//aternatively : a,b,c,d
 	uint32_t count = 0;
 };
 
-int dirSign(float val)
+typedef tsimplex<float> simplex;
+
+template <typename T>
+int dirSign(T val)
 {
 	if (val < -0.0001)return -1;
 	return 1;
 }
 
-void simplexMin(simplex& S, const vec3& P)
+//Signed volumes distance subalgorithm (Montanari, Petrinic and Barbieri 2017)
+//	Each sub-simplex's determinant is split into the cofactors of its vertices,
+//		a cofactor sharing the determinant's sign keeps that vertex and the
+//		cofactors divided by the determinant are the barycentric weights of
+//		the closest point, so the point and the smallest simplex holding it
+//		come from one pass.
+//	Only faces and edges opposite a vertex with a mismatched sign are visited,
+//		and the simplex is compacted in place, oldest vertex first.
+//	The tetrahedron's signs come from the exact orient3d predicate, segments and
+//		triangles use the float cofactors.
+template <typename T>
+struct tSubsimplex
+{
+	uint32_t count = 0;
+	uint32_t slots[4] = { 0, 0, 0, 0 };
+	T weights[4] = { 0, 0, 0, 0 };
+	//Closest point, taken from the projection rather than summed from the weights,
+	//	which keeps its direction accurate when the origin is nearly on the sub-simplex
+	tvec3<T> point;
+};
+
+template <typename T>
+bool sameSign(const T a, const T b)
+{
+	return (a > T(0) && b > T(0)) || (a < T(0) && b < T(0));
+}
+
+template <typename T>
+void signedVolume1D(const tsimplex<T>& S, const uint32_t a, const uint32_t b, tSubsimplex<T>& sub)
 {
-	//reduces 3d simplex to 2d
-	if (S.count == 4)
+	const tvec3<T>& A = S.verts[a];
+	const tvec3<T>& B = S.verts[b];
+	tvec3<T> t = B - A;
+	T tt = dot(t, t);
+	//Projected onto the segment's dominant axis, where the segment's length cannot vanish
+	T mu, ca, cb;
+	if (tt > T(0))
 	{
-		vec3 ABC = closestPoint(P, S.verts[3], S.verts[2], S.verts[1]),
-			ABD = closestPoint(P, S.verts[3], S.verts[2], S.verts[0]),
-			BCD = closestPoint(P, S.verts[2], S.verts[1], S.verts[0]),
-			ACD = closestPoint(P, S.verts[3], S.verts[1], S.verts[0]);
-		if (dot(ABC, ABC) < dot(ABD, ABD))
+		tvec3<T> p = A - t * (dot(A, t) / tt);
+		T ax = std::abs(t.x), ay = std::abs(t.y), az = std::abs(t.z);
+		if (ax >= ay && ax >= az)
 		{
-			if (dot(ABC, ABC) < dot(BCD, BCD))
-			{
-				S.verts[0] = S.verts[3];
-				//S.inds[0] = S.inds[3];
-				S.aID[0] = S.aID[3];
-				S.bID[0] = S.bID[3];
-			}
+			mu = A.x - B.x; ca = p.x - B.x; cb = A.x - p.x;
+		}
+		else if (ay >= az)
+		{
+			mu = A.y - B.y; ca = p.y - B.y; cb = A.y - p.y;
 		}
 		else
 		{
-			if (dot(ABD, ABD) < dot(BCD, BCD))
-			{
-				S.verts[1] = S.verts[0];
-				S.verts[0] = S.verts[3];
-				//S.inds[1] = S.inds[0];
-				S.aID[1] = S.aID[0];
-				S.bID[1] = S.bID[0];
-				//S.inds[0] = S.inds[3];
-				S.aID[0] = S.aID[3];
-				S.bID[0] = S.bID[3];
-			}
+			mu = A.z - B.z; ca = p.z - B.z; cb = A.z - p.z;
+		}
+		if (sameSign(mu, ca) && sameSign(mu, cb))
+		{
+			sub.count = 2;
+			sub.slots[0] = a;
+			sub.slots[1] = b;
+			sub.weights[0] = ca / mu;
+			sub.weights[1] = cb / mu;
+			sub.point = p;
+			return;
 		}
-		S.count = 3;
 	}
+	//The closer endpoint, the newer one when the segment is degenerate
+	sub.count = 1;
+	sub.slots[0] = (tt > T(0) && dot(A, A) < dot(B, B)) ? a : b;
+	sub.weights[0] = T(1);
+	sub.point = S.verts[sub.slots[0]];
 }
 
-float gjkDistance(const Shape& A, const Shape& B, const vec3& bOffset)
+//Picks the candidate closer to the origin
+template <typename T>
+void closerSubsimplex(const tSubsimplex<T>& candidate, tSubsimplex<T>& best, T& bestDistSq)
 {
-	vec3 D(1.0f, 0.25f, 0.5f);
-	uint32_t supportA = A.supportPoint((-1.0f * D)),
-		supportB = B.supportPoint(D);
-	vec3 minkowskiDifference = (B.getVertex(supportB) + bOffset) -
-		A.getVertex(supportA);
-	simplex S;
-	S.verts[0] = minkowskiDifference;
-	//S.inds[0].first = supportA;
-	//S.inds[0].second = supportB;
-	S.aID[0] = supportA;
-	S.bID[0] = supportB;
-	D = (D * -1.0f);
-	//get line segment -- I.E. 1D simplex
-	supportA = A.supportPoint((-1.0f * D));
-	supportB = B.supportPoint(D);
-	minkowskiDifference = (B.getVertex(supportB) + bOffset) -
-		A.getVertex(supportA);
-	S.verts[1] = minkowskiDifference;
-	//S.inds[1].first = supportA;
-	//S.inds[1].second = supportB;
-	S.aID[1] = supportA;
-	S.bID[1] = supportB;
-	S.count = 2;
-	D = closestPoint(vec3(0.0f, 0.0f, 0.0f), S.verts[1], S.verts[0]);
-	bool intersection = false;
-	bool end = false;
-	while (!end)
+	T distSq = dot(candidate.point, candidate.point);
+	if (distSq < bestDistSq)
+	{
+		bestDistSq = distSq;
+		best = candidate;
+	}
+}
+
+template <typename T>
+void signedVolume2D(const tsimplex<T>& S, const uint32_t a, const uint32_t b, const uint32_t c, tSubsimplex<T>& sub)
+{
+	const tvec3<T>& A = S.verts[a];
+	const tvec3<T>& B = S.verts[b];
+	const tvec3<T>& C = S.verts[c];
+	tvec3<T> n = cross(B - A, C - A);
+	T nn = dot(n, n);
+	T edge = std::max(dot(B - A, B - A), dot(C - A, C - A));
+	if (nn > std::numeric_limits<T>::epsilon() * edge * edge)
 	{
-		D = -1.0f * D;
-		if (D.x == 0.0f && D.y == 0.0f && D.z == 0.0f)
+		//The origin projected into the plane, then areas taken in the two axes that keep the triangle largest
+		tvec3<T> p = n * (dot(A, n) / nn);
+		T nx = std::abs(n.x), ny = std::abs(n.y), nz = std::abs(n.z);
+		T au, av, bu, bv, cu, cv, pu, pv;
+		if (nx >= ny && nx >= nz)
 		{
-			intersection = true;
-			end = true;
-			break;
+			au = A.y; av = A.z; bu = B.y; bv = B.z; cu = C.y; cv = C.z; pu = p.y; pv = p.z;
 		}
-		supportA = A.supportPoint((-1.0f * D));
-		supportB = B.supportPoint(D);
-		minkowskiDifference = (B.getVertex(supportB) + bOffset) -
-			A.getVertex(supportA);
-		switch (S.count)
-		{
-		case 2:
+		else if (ny >= nz)
 		{
-			if (S.aID[0] == supportA && S.bID[0] == supportB)
-			{
-				intersection = false;
-				end = true;
-				break;
-			}
-			if (S.aID[1] == supportA && S.bID[1] == supportB)
-			{
-				intersection = false;
-				end = true;
-				break;
-			}
-			S.verts[2] = minkowskiDifference;
-			//S.inds[2].first = supportA;
-			//S.inds[2].second = supportB;
-			S.aID[2] = supportA;
-			S.bID[2] = supportB;
-			S.count = 3;
-			break;
+			au = A.z; av = A.x; bu = B.z; bv = B.x; cu = C.z; cv = C.x; pu = p.z; pv = p.x;
 		}
-		case 3:
+		else
 		{
-			if (S.aID[0] == supportA && S.bID[0] == supportB)
-			{
-				intersection = false;
-				end = true;
-				break;
-			}
-			if (S.aID[1] == supportA && S.bID[1] == supportB)
-			{
-				intersection = false;
-				end = true;
-				break;
-			}
-			if (S.aID[2] == supportA && S.bID[2] == supportB)
-			{
-				intersection = false;
-				end = true;
-				break;
-			}
-			S.verts[3] = minkowskiDifference;
-			//S.inds[3].first = supportA;
-			//S.inds[3].second = supportB;
-			S.aID[3] = supportA;
-			S.bID[3] = supportB;
-			S.count = 4;
-			simplexMin(S, vec3(0.0f, 0.0f, 0.0f));
-			break;
+			au = A.x; av = A.y; bu = B.x; bv = B.y; cu = C.x; cv = C.y; pu = p.x; pv = p.y;
 		}
-		default:break;//bad dimensions
+		T ca = (bu - pu) * (cv - pv) - (bv - pv) * (cu - pu);
+		T cb = (cu - pu) * (av - pv) - (cv - pv) * (au - pu);
+		T cc = (au - pu) * (bv - pv) - (av - pv) * (bu - pu);
+		T mu = ca + cb + cc;
+		bool keepA = sameSign(mu, ca), keepB = sameSign(mu, cb), keepC = sameSign(mu, cc);
+		if (keepA && keepB && keepC)
+		{
+			sub.count = 3;
+			sub.slots[0] = a;
+			sub.slots[1] = b;
+			sub.slots[2] = c;
+			sub.weights[0] = ca / mu;
+			sub.weights[1] = cb / mu;
+			sub.weights[2] = cc / mu;
+			sub.point = p;
+			return;
 		}
-		if (end)
+		T bestDistSq = std::numeric_limits<T>::max();
+		tSubsimplex<T> candidate;
+		if (!keepA)
 		{
-			//repeating indices, likely no intersection
-			break;
+			signedVolume1D(S, b, c, candidate);
+			closerSubsimplex(candidate, sub, bestDistSq);
 		}
-		vec3 tempD;
-		switch (S.count)
+		if (!keepB)
 		{
-		case 2:
+			signedVolume1D(S, a, c, candidate);
+			closerSubsimplex(candidate, sub, bestDistSq);
+		}
+		if (!keepC)
 		{
-			tempD = closestPoint(vec3(0.0f, 0.0f, 0.0f), S.verts[1], S.verts[0]);
-			break;
+			signedVolume1D(S, a, b, candidate);
+			closerSubsimplex(candidate, sub, bestDistSq);
 		}
-		case 3:
+		return;
+	}
+	//Collinear, the answer lies on one of the edges
+	T bestDistSq = std::numeric_limits<T>::max();
+	tSubsimplex<T> candidate;
+	signedVolume1D(S, b, c, candidate);
+	closerSubsimplex(candidate, sub, bestDistSq);
+	signedVolume1D(S, a, c, candidate);
+	closerSubsimplex(candidate, sub, bestDistSq);
+	signedVolume1D(S, a, b, candidate);
+	closerSubsimplex(candidate, sub, bestDistSq);
+}
+
+template <typename T>
+void signedVolume3D(const tsimplex<T>& S, tSubsimplex<T>& sub)
+{
+	const tvec3<T>& A = S.verts[0];
+	const tvec3<T>& B = S.verts[1];
+	const tvec3<T>& C = S.verts[2];
+	const tvec3<T>& D = S.verts[3];
+	//Which vertices to keep comes from exact orientation tests, so near flat tetrahedra cannot flip a sign and cycle
+	bool keep[4];
+	if (tetrahedronSides(A, B, C, D, tvec3<T>(0.0f, 0.0f, 0.0f), keep))
+	{
+		//Cofactors are the volumes with the origin in place of each vertex, they only weight the enclosed origin
+		T ca = dot(B, cross(C, D));
+		T cb = -dot(A, cross(C, D));
+		T cc = dot(A, cross(B, D));
+		T cd = -dot(A, cross(B, C));
+		T mu = ca + cb + cc + cd;
+		sub.count = 4;
+		sub.slots[0] = 0;
+		sub.slots[1] = 1;
+		sub.slots[2] = 2;
+		sub.slots[3] = 3;
+		sub.weights[0] = (mu != T(0)) ? ca / mu : T(0.25);
+		sub.weights[1] = (mu != T(0)) ? cb / mu : T(0.25);
+		sub.weights[2] = (mu != T(0)) ? cc / mu : T(0.25);
+		sub.weights[3] = (mu != T(0)) ? cd / mu : T(0.25);
+		sub.point = tvec3<T>(0.0f, 0.0f, 0.0f);
+		return;
+	}
+	//A flat tetrahedron has no sign to match, so every face is a candidate
+	//	All four faces are scored at once, and only the nearest candidate is reduced for its slots and weights
+	tTriangleLanes<T> lanes;
+	tPointLanes<T> nearest;
+	tetrahedronFaceLanes(A, B, C, D, lanes);
+	closestPointLanes(tvec3<T>(0.0f, 0.0f, 0.0f), lanes, nearest);
+	//Lane i holds the face opposite of vertex opposite[i], made of the slots in faces[i]
+	const uint32_t opposite[4] = { 0, 3, 2, 1 };
+	const uint32_t faces[4][3] = { { 1, 2, 3 }, { 0, 1, 2 }, { 0, 1, 3 }, { 0, 2, 3 } };
+	int best = -1;
+	for (int i = 0; i < 4; ++i)
+	{
+		if (keep[opposite[i]])continue;
+		if (best < 0 || nearest.distSq[i] < nearest.distSq[best])best = i;
+	}
+	signedVolume2D(S, faces[best][0], faces[best][1], faces[best][2], sub);
+}
+
+//Reduces S to the smallest sub-simplex holding its point closest to the origin and returns that point
+//	The weights of the kept vertices are left in S.weights
+template <typename T>
+tvec3<T> simplexMin(tsimplex<T>& S)
+{
+	tSubsimplex<T> sub;
+	switch (S.count)
+	{
+	case 1:
+	{
+		sub.count = 1;
+		sub.weights[0] = T(1);
+		sub.point = S.verts[0];
+		break;
+	}
+	case 2: signedVolume1D(S, 0, 1, sub); break;
+	case 3: signedVolume2D(S, 0, 1, 2, sub); break;
+	case 4: signedVolume3D(S, sub); break;
+	default: return tvec3<T>(0.0f, 0.0f, 0.0f);
+	}
+	tvec3<T> point = sub.point;
+	//Slots are ascending, so compacting in place never overwrites a vertex still to be moved
+	for (uint32_t i = 0; i < sub.count; ++i)
+	{
+		uint32_t slot = sub.slots[i];
+		S.verts[i] = S.verts[slot];
+		S.aID[i] = S.aID[slot];
+		S.bID[i] = S.bID[slot];
+		S.aPoints[i] = S.aPoints[slot];
+		S.bPoints[i] = S.bPoints[slot];
+		S.weights[i] = sub.weights[i];
+	}
+	S.count = sub.count;
+	return point;
+}
+
+//A repeated pair of support ids means no further progress, shapes without vertices never repeat
+template <typename T>
+bool repeatedSupport(const tsimplex<T>& S, const uint32_t slot, const uint32_t supportA, const uint32_t supportB)
+{
+	return S.aID[slot] == supportA && S.bID[slot] == supportB && supportA != noFeatureID && supportB != noFeatureID;
+}
+
+//Support point of B - A along D in the frame of A, a and b receive the support points on each shape
+//	The ids carry the previous support points in as seeds
+template <typename T, typename ShapeA, typename ShapeB>
+tvec3<T> minkowskiSupport(const ShapeA& A, const ShapeB& B, const tmat3<T>& bRotation, const tvec3<T>& bOffset,
+	const tvec3<T>& D, uint32_t& supportA, uint32_t& supportB, tvec3<T>& a, tvec3<T>& b)
+{
+	a = A.supportVertex((-1.0f * D), supportA);
+	b = (bRotation * B.supportVertex(transposeMultiply(bRotation, D), supportB)) + bOffset;
+	return b - a;
+}
+
+//Support point of B - A along D written to the simplex's next free slot, keeping the points on each shape
+//	The slot is only taken once the caller increments S.count
+template <typename T, typename ShapeA, typename ShapeB>
+const tvec3<T>& nextSupport(const ShapeA& A, const ShapeB& B, const tmat3<T>& bRotation, const tvec3<T>& bOffset,
+	const tvec3<T>& D, uint32_t& supportA, uint32_t& supportB, tsimplex<T>& S)
+{
+	uint32_t slot = S.count;
+	S.verts[slot] = minkowskiSupport(A, B, bRotation, bOffset, D, supportA, supportB, S.aPoints[slot], S.bPoints[slot]);
+	return S.verts[slot];
+}
+
+//Gap between the bounding spheres of A and of B placed in A's frame, negative when they overlap
+//	centers is left holding the offset from A's center to B's
+template <typename T>
+T boundsGap(const tBounds<T>& aBounds, const tBounds<T>& bBounds, const tmat3<T>& bRotation, const tvec3<T>& bOffset, tvec3<T>& centers)
+{
+	centers = ((bRotation * bBounds.center) + bOffset) - aBounds.center;
+	return std::sqrt(dot(centers, centers)) - aBounds.radius - bBounds.radius;
+}
+
+//The distance loop shared by every query that needs the final simplex
+//	Returns whether the origin is enclosed (or touched), S is left reduced to the vertices supporting closest
+//	A non-negative margin stops the loop once a support point lies further than margin behind the plane
+//		through the origin, a separating axis, and with stopWithin also once closest is within it
+//		On a separating axis closest is left as the nearest point of that plane, a lower bound on the distance
+template <typename T, typename ShapeA, typename ShapeB>
+bool gjkSolve(const ShapeA& A, const ShapeB& B, const tmat3<T>& bRotation, const tvec3<T>& bOffset, tsimplex<T>& S, tvec3<T>& closest, uint32_t& itr,
+	const T margin = T(-1), const bool stopWithin = true)
+{
+	//Curved shapes converge without ever repeating a support point, so progress and iterations are bounded too
+	const T progressTolerance = std::numeric_limits<T>::epsilon() * T(64);
+	const T touchTolerance = std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon() * T(1024);
+	const uint32_t maximumIterations = 128;
+	const T marginSq = margin * margin;
+	tvec3<T> D(1.0f, 0.25f, 0.5f);
+	//Each support query is seeded with the previous support point, so large convex meshes hill climb
+	uint32_t supportA = 0, supportB = 0;
+	S.count = 0;
+	nextSupport(A, B, bRotation, bOffset, D, supportA, supportB, S);
+	S.aID[0] = supportA;
+	S.bID[0] = supportB;
+	S.count = 1;
+	D = (D * -1.0f);
+	//get line segment -- I.E. 1D simplex
+	nextSupport(A, B, bRotation, bOffset, D, supportA, supportB, S);
+	S.aID[1] = supportA;
+	S.bID[1] = supportB;
+	S.count = 2;
+	closest = simplexMin(S);
+	itr = 0;
+	while (itr < maximumIterations)
+	{
+		++itr;
+		//Closer to the origin than rounding allows at the simplex's scale, touching at least
+		T scale = T(0);
+		for (uint32_t i = 0; i < S.count; ++i)
 		{
-			tempD = closestPoint(vec3(0.0f, 0.0f, 0.0f), S.verts[2], S.verts[1], S.verts[0]);
-			break;
+			scale = std::max(scale, dot(S.verts[i], S.verts[i]));
 		}
-		default: end = true; intersection = true; break;//intersection likely
+		if (dot(closest, closest) <= touchTolerance * scale)return true;
+		if (stopWithin && margin >= T(0) && dot(closest, closest) <= marginSq)return false;
+		D = -1.0f * closest;
+		const tvec3<T>& minkowskiDifference = nextSupport(A, B, bRotation, bOffset, D, supportA, supportB, S);
+		T reached = dot(D, minkowskiDifference);
+		if (margin >= T(0) && reached < T(0) && reached * reached > marginSq * dot(D, D))
+		{
+			closest = D * (reached / dot(D, D));
+			return false;
 		}
-		if (dot(D, D) <= dot(tempD, tempD))
+		//The new point gets no closer to the origin than the current closest point
+		if (dot(D, D) + reached <= progressTolerance * dot(D, D))return false;
+		//repeating indices, no intersection
+		for (uint32_t i = 0; i < S.count; ++i)
 		{
-			//shortest distance probably found, likely no intersection
-			end = true;
-			intersection = false;
-			break;
+			if (repeatedSupport(S, i, supportA, supportB))return false;
 		}
-		else
+		S.aID[S.count] = supportA;
+		S.bID[S.count] = supportB;
+		++S.count;
+		//Closest point and the vertices supporting it, the rest are dropped
+		tvec3<T> tempD = simplexMin(S);
+		//tetrahedron encloses the origin
+		if (S.count == 4)return true;
+		//Signed volumes always reduce the distance while progress is made, anything else is rounding
+		//	The reduced simplex is kept with its own closest point, the two differ by rounding only
+		if (dot(closest, closest) <= dot(tempD, tempD))
 		{
-			D = tempD;
+			closest = tempD;
+			return false;
 		}
+		closest = tempD;
 	}
-	if (intersection)
+	return false;
+}
+
+//Everything the distance loop ends with, in A's frame
+template <typename T>
+struct tDistanceResult
+{
+	//As gjkDistance, -1 when intersecting and a lower bound when culled
+	T distance = 0;
+	//Closest points on A and on B, equal inside the overlap when intersecting
+	tvec3<T> pointA, pointB;
+	//Support ids of the final simplex's vertices, one, two or three distinct ids per shape give
+	//	a vertex, an edge or a face of it, noFeatureID for implicit shapes
+	uint32_t featureCount = 0;
+	uint32_t aID[4] = { 0, 0, 0, 0 };
+	uint32_t bID[4] = { 0, 0, 0, 0 };
+	uint32_t iterations = 0;
+};
+
+typedef tDistanceResult<float> DistanceResult;
+
+//gjkDistance keeping the closest points and features, weighted from the simplex the loop already holds
+template <typename T, typename ShapeA, typename ShapeB>
+tDistanceResult<T> gjkClosestPoints(const ShapeA& A, const ShapeB& B, const ttransform<T>& bRelative, const T cullDistance = std::numeric_limits<T>::max())
+{
+	tDistanceResult<T> result;
+	//Expanded once so each support call costs a single 3x3 product
+	tmat3<T> bRotation = toMat3(bRelative.orientation);
+	const tvec3<T>& bOffset = bRelative.position;
+	//Pairs whose bounding spheres are further apart than cullDistance only get that lower bound
+	const tBounds<T>& aBounds = A.getBounds();
+	const tBounds<T>& bBounds = B.getBounds();
+	tvec3<T> centers;
+	T gap = boundsGap(aBounds, bBounds, bRotation, bOffset, centers);
+	if (gap > cullDistance)
 	{
-		return -1.0f;
+		//Culled pairs only get the nearest points of the bounding spheres
+		tvec3<T> direction = centers / (gap + aBounds.radius + bBounds.radius);
+		result.distance = gap;
+		result.pointA = aBounds.center + direction * aBounds.radius;
+		result.pointB = aBounds.center + direction * (gap + aBounds.radius);
+		return result;
 	}
-	else
+	//A separating axis further out than cullDistance also ends the solve with a lower bound
+	tsimplex<T> S;
+	tvec3<T> closest;
+	bool intersection = gjkSolve(A, B, bRotation, bOffset, S, closest, result.iterations,
+		(cullDistance < std::numeric_limits<T>::max()) ? cullDistance : T(-1), false);
+	result.distance = intersection ? T(-1) : std::sqrt(dot(closest, closest));
+	result.pointA = S.aPoints[0] * S.weights[0];
+	result.pointB = S.bPoints[0] * S.weights[0];
+	for (uint32_t i = 1; i < S.count; ++i)
+	{
+		result.pointA = result.pointA + S.aPoints[i] * S.weights[i];
+		result.pointB = result.pointB + S.bPoints[i] * S.weights[i];
+	}
+	result.featureCount = S.count;
+	for (uint32_t i = 0; i < S.count; ++i)
+	{
+		result.aID[i] = S.aID[i];
+		result.bID[i] = S.bID[i];
+	}
+	return result;
+}
+
+template <typename T, typename ShapeA, typename ShapeB>
+tDistanceResult<T> gjkClosestPoints(const ShapeA& A, const ShapeB& B, const tvec3<T>& bOffset, const T cullDistance = std::numeric_limits<T>::max())
+{
+	return gjkClosestPoints(A, B, ttransform<T>(bOffset), cullDistance);
+}
+
+//Distance between A and B, -1 when intersecting
+//	Pairs found further apart than cullDistance, by their bounding spheres or a separating axis, only get a lower bound
+template <typename T, typename ShapeA, typename ShapeB>
+T gjkDistance(const ShapeA& A, const ShapeB& B, const ttransform<T>& bRelative, uint32_t* iterations = nullptr, const T cullDistance = std::numeric_limits<T>::max())
+{
+	tDistanceResult<T> result = gjkClosestPoints(A, B, bRelative, cullDistance);
+	if (iterations != nullptr)*iterations = result.iterations;
+	return result.distance;
+}
+
+template <typename T, typename ShapeA, typename ShapeB>
+T gjkDistance(const ShapeA& A, const ShapeB& B, const tvec3<T>& bOffset, uint32_t* iterations = nullptr, const T cullDistance = std::numeric_limits<T>::max())
+{
+	return gjkDistance(A, B, ttransform<T>(bOffset), iterations, cullDistance);
+}
+
+template <typename T, typename ShapeA, typename ShapeB>
+T gjkDistance(const ShapeA& A, const ttransform<T>& aTransform, const ShapeB& B, const ttransform<T>& bTransform)
+{
+	return gjkDistance(A, B, inverse(aTransform) * bTransform);
+}
+
+//Whether B comes within margin of A, stopping at the first answer rather than converging on the distance
+template <typename T, typename ShapeA, typename ShapeB>
+bool gjkWithinMargin(const ShapeA& A, const ShapeB& B, const ttransform<T>& bRelative, const T margin, uint32_t* iterations = nullptr)
+{
+	tmat3<T> bRotation = toMat3(bRelative.orientation);
+	const tvec3<T>& bOffset = bRelative.position;
+	tvec3<T> centers;
+	if (boundsGap(A.getBounds(), B.getBounds(), bRotation, bOffset, centers) > margin)
 	{
-		return std::sqrt(dot(D, D));
+		if (iterations != nullptr)*iterations = 0;
+		return false;
 	}
+	tsimplex<T> S;
+	tvec3<T> closest;
+	uint32_t itr = 0;
+	bool intersection = gjkSolve(A, B, bRotation, bOffset, S, closest, itr, margin);
+	if (iterations != nullptr)*iterations = itr;
+	return intersection || dot(closest, closest) <= margin * margin;
+}
+
+template <typename T, typename ShapeA, typename ShapeB>
+bool gjkWithinMargin(const ShapeA& A, const ShapeB& B, const tvec3<T>& bOffset, const T margin, uint32_t* iterations = nullptr)
+{
+	return gjkWithinMargin(A, B, ttransform<T>(bOffset), margin, iterations);
+}
+
+//Touching counts as intersecting
+template <typename T, typename ShapeA, typename ShapeB>
+bool gjkIntersect(const ShapeA& A, const ShapeB& B, const ttransform<T>& bRelative, uint32_t* iterations = nullptr)
+{
+	return gjkWithinMargin(A, B, bRelative, T(0), iterations);
 }
 
-std::pair<float, float> gjkToI(const Shape& A, const Shape& B, const vec3& bOffset, vec3 bVelocity)
+template <typename T, typename ShapeA, typename ShapeB>
+bool gjkIntersect(const ShapeA& A, const ShapeB& B, const tvec3<T>& bOffset, uint32_t* iterations = nullptr)
 {
-	std::pair<float, float> result(std::pair<float, float>(-1.0f, -1.0f));
-	float start = 0.0f, end = 1.0f, current;
+	return gjkWithinMargin(A, B, ttransform<T>(bOffset), T(0), iterations);
+}
+
+//B's bounding sphere swept over the step never comes within margin of A's, with B placed and moving in A's frame
+template <typename T>
+bool sweptBoundsMiss(const tBounds<T>& aBounds, const tBounds<T>& bBounds, const ttransform<T>& bRelative, const tvec3<T>& localVelocity, const T margin)
+{
+	tvec3<T> bCenter = transformPoint(bRelative, bBounds.center);
+	T reach = aBounds.radius + bBounds.radius + margin;
+	return segmentPointDistanceSq(bCenter, localVelocity, aBounds.center) > reach * reach;
+}
+
+template <typename T, typename ShapeA, typename ShapeB>
+std::pair<T, T> gjkToI(const ShapeA& A, const ttransform<T>& aTransform, const ShapeB& B, const ttransform<T>& bTransform, const tvec3<T>& bVelocity, uint32_t* bisections = nullptr)
+{
+	std::pair<T, T> result(std::pair<T, T>(-1.0f, -1.0f));
+	//Linear motion only, orientations are held constant over the time step
+	ttransform<T> relative = inverse(aTransform) * bTransform;
+	tvec3<T> bOffset = relative.position;
+	tvec3<T> localVelocity = inverseTransformDirection(aTransform, bVelocity);
+	T start = 0.0f, end = 1.0f, current;
 	//Assuming 1 arbitrary time unit traveled
-	float intersection = 0.01f;
-	float distance = 1.0f;
+	T intersection = 0.01f;
+	T distance = 1.0f;
+	//No ToI to search for
+	if (sweptBoundsMiss(A.getBounds(), B.getBounds(), relative, localVelocity, intersection))
+	{
+		if (bisections != nullptr)*bisections = 0;
+		return result;
+	}
 	unsigned int maximumItr = 0; //In case a valid (i.e. will intersect) case is provided, stop after this many iterations
 	while (maximumItr < 1000)
 	{
 		current = (start + end) * 0.5f;
-		distance = gjkDistance(A, B, (bVelocity * current) + bOffset);
+		relative.position = (localVelocity * current) + bOffset;
+		//One query per step, culling at the margin: steps short of it stop at a lower bound, the rest converge
+		distance = gjkDistance(A, B, relative, nullptr, intersection);
 		if (distance < -0.5)
 		{
 			//intersection occurred
@@ -250,8 +614,15 @@ std::pair<float, float> gjkToI(const Shape& A, const Shape& B, const vec3& bOffs
 		}
 		++maximumItr;
 	}
+	if (bisections != nullptr)*bisections = maximumItr;
 
 	return result;
 }
 
+template <typename T, typename ShapeA, typename ShapeB>
+std::pair<T, T> gjkToI(const ShapeA& A, const ShapeB& B, const tvec3<T>& bOffset, tvec3<T> bVelocity, uint32_t* bisections = nullptr)
+{
+	return gjkToI(A, ttransform<T>(), B, ttransform<T>(bOffset), bVelocity, bisections);
+}
+
 #endif
\ No newline at end of file
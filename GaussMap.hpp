@@ -0,0 +1,171 @@
+/*
+Purpose: Gauss maps of convex meshes for pruning edge-edge contact tests.
+	On the unit sphere each face normal is a point and each edge is the arc
+		between the normals of its two faces.
+	Two edges, one per shape, can only touch across a face of the Minkowski
+		difference when A's arc crosses B's arc with B's normals negated.
+		Each crossing test is four dot products against arc normals stored
+		at build time, so most edge pairs are discarded before any geometry.
+	Orientations are held constant over a ToI step, so the surviving pairs are
+		found once per step and every bisection or edge ToI reuses them,
+		which leaves a number of candidates near the edge counts of the
+		shapes rather than their product.
+	Built from a closed tHalfEdgeMesh, each edge is listed once.
+*/
+
+#ifndef __GAUSS_MAP__
+#define __GAUSS_MAP__
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "VectorMath.hpp"
+#include "Shape.hpp"
+#include "HalfEdge.hpp"
+
+template <typename T>
+struct tGaussArc
+{
+	tvec3<T> u, v;//normals of the faces on either side
+	tvec3<T> arc;//cross(v, u), normal of the arc's great circle
+	int tail, head;//vertex indices of the edge
+};
+
+template <typename T>
+class tGaussMap
+{
+public:
+	tGaussMap()
+	{
+		//NULL
+	}
+	explicit tGaussMap(const tHalfEdgeMesh<T>& mesh)
+	{
+		build(mesh);
+	}
+	~tGaussMap()
+	{
+		release();
+	}
+	tGaussMap(const tGaussMap&) = delete;
+	tGaussMap& operator=(const tGaussMap&) = delete;
+	void build(const tHalfEdgeMesh<T>& mesh)
+	{
+		release();
+		const tShape<T>& source = mesh.getShape();
+		shape = &source;
+		for (int e = 0; e < mesh.halfEdgeCount; ++e)
+		{
+			if (mesh.twin(e) > e)++edgeCount;
+		}
+		arcs = new tGaussArc<T>[edgeCount];
+		int index = 0;
+		for (int e = 0; e < mesh.halfEdgeCount; ++e)
+		{
+			if (mesh.twin(e) <= e)continue;
+			tGaussArc<T>& arc = arcs[index++];
+			arc.u = source.faces[mesh.face(e)];
+			arc.v = source.faces[mesh.face(mesh.twin(e))];
+			arc.arc = cross(arc.v, arc.u);
+			arc.tail = mesh.origin(e);
+			arc.head = mesh.target(e);
+		}
+	}
+	const tShape<T>& getShape() const
+	{
+		return *shape;
+	}
+	int edgeCount = 0;
+	tGaussArc<T>* arcs = nullptr;
+private:
+	void release()
+	{
+		if (arcs != nullptr)
+		{
+			delete[] arcs;
+			arcs = nullptr;
+		}
+		edgeCount = 0;
+	}
+	const tShape<T>* shape = nullptr;
+};
+
+typedef tGaussMap<float> GaussMap;
+
+//Whether arc a-b crosses arc c-d, given bxa = cross(b, a) and dxc = cross(d, c)
+//	c and d on the same side of a-b's great circle rule it out, as do a and b on the same side of c-d's,
+//	and the last test rejects the antipodal crossing
+template <typename T>
+bool isMinkowskiFace(const tvec3<T>& a, const tvec3<T>& b, const tvec3<T>& bxa, const tvec3<T>& c, const tvec3<T>& d, const tvec3<T>& dxc)
+{
+	T cba = dot(c, bxa);
+	T dba = dot(d, bxa);
+	T adc = dot(a, dxc);
+	T bdc = dot(b, dxc);
+	return (cba * dba < T(0)) && (adc * bdc < T(0)) && (cba * bdc > T(0));
+}
+
+//Edge pairs (index into A's arcs, index into B's arcs) that form a face of the Minkowski difference, B rotated into A's frame
+template <typename T>
+void minkowskiEdgePairs(const tGaussMap<T>& A, const tGaussMap<T>& B, const tmat3<T>& bRotation, std::vector<std::pair<int, int>>& pairs)
+{
+	pairs.clear();
+	//B's arcs negated and rotated once, negating both normals leaves cross(v, u) unchanged
+	std::vector<tGaussArc<T>> rotated(B.edgeCount);
+	for (int j = 0; j < B.edgeCount; ++j)
+	{
+		rotated[j].u = T(-1) * (bRotation * B.arcs[j].u);
+		rotated[j].v = T(-1) * (bRotation * B.arcs[j].v);
+		rotated[j].arc = bRotation * B.arcs[j].arc;
+	}
+	for (int i = 0; i < A.edgeCount; ++i)
+	{
+		const tGaussArc<T>& a = A.arcs[i];
+		for (int j = 0; j < B.edgeCount; ++j)
+		{
+			const tGaussArc<T>& b = rotated[j];
+			if (isMinkowskiFace(a.u, a.v, a.arc, b.u, b.v, b.arc))pairs.push_back(std::make_pair(i, j));
+		}
+	}
+}
+
+//Earliest time in [0, 1] that an edge of B, moving by bVelocity, crosses an edge of A, or -1 when none does
+//	Only the given Minkowski face pairs are tested, everything is in A's frame
+template <typename T>
+T edgeEdgeToI(const tGaussMap<T>& A, const tGaussMap<T>& B, const ttransform<T>& bRelative, const tvec3<T>& bVelocity, const std::vector<std::pair<int, int>>& pairs)
+{
+	const tShape<T>& shapeA = A.getShape();
+	const tShape<T>& shapeB = B.getShape();
+	tmat3<T> bRotation = toMat3(bRelative.orientation);
+	const tvec3<T>& center = shapeA.getBounds().center;
+	T earliest = T(2);
+	for (const std::pair<int, int>& pair : pairs)
+	{
+		const tGaussArc<T>& a = A.arcs[pair.first];
+		const tGaussArc<T>& b = B.arcs[pair.second];
+		const tvec3<T>& p = shapeA.vertices[a.tail];
+		tvec3<T> e1 = shapeA.vertices[a.head] - p;
+		tvec3<T> q = (bRotation * shapeB.vertices[b.tail]) + bRelative.position;
+		tvec3<T> e2 = bRotation * (shapeB.vertices[b.head] - shapeB.vertices[b.tail]);
+		tvec3<T> axis = cross(e1, e2);
+		T nn = dot(axis, axis);
+		if (nn <= std::numeric_limits<T>::epsilon() * dot(e1, e1) * dot(e2, e2))continue;//parallel edges
+		//Separation is measured out of A through its edge
+		tvec3<T> n = (dot(axis, p - center) < T(0)) ? T(-1) * axis : axis;
+		T separation = dot(n, q - p);
+		T closing = dot(n, bVelocity);
+		if (separation < T(0) || closing >= T(0))continue;
+		T t = separation / -closing;
+		if (t > T(1) || t >= earliest)continue;
+		//Both edges lie in one plane at t, the crossing must be within both segments
+		tvec3<T> r = (q + bVelocity * t) - p;
+		T s = dot(cross(r, e2), axis) / nn;
+		T u = dot(cross(r, e1), axis) / nn;
+		if (s < T(0) || s > T(1) || u < T(0) || u > T(1))continue;
+		earliest = t;
+	}
+	return (earliest > T(1)) ? T(-1) : earliest;
+}
+
+#endif
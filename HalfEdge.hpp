@@ -0,0 +1,214 @@
+/*
+Purpose: Half-edge connectivity over a tShape's triangles for feature walks.
+	Half-edge 3 * f + k runs from faceVerts[f].ind[k] to ind[(k + 1) % 3], so
+		its face, next and previous half-edges are implied by its index and
+		only the origin vertex and the opposite (twin) half-edge are stored.
+	Every vertex keeps one outgoing half-edge, from which its fan of faces is
+		walked in order, and an edge's two faces are its half-edge's face and
+		its twin's face.
+		Contact tracking, SAT edge tests and face culling can then step between
+		neighboring features instead of scanning every face.
+	Edges used by only one face, or by more than two, have no twin (-1) and
+		mark the mesh as not closed; walks stop at them.
+	Built from a tShape whose faces are wound consistently, e.g. the output of
+		convexHull, and the shape must outlive the structure.
+*/
+
+#ifndef __HALF_EDGE__
+#define __HALF_EDGE__
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "VectorMath.hpp"
+#include "Shape.hpp"
+
+template <typename T>
+class tHalfEdgeMesh
+{
+public:
+	tHalfEdgeMesh()
+	{
+		//NULL
+	}
+	explicit tHalfEdgeMesh(const tShape<T>& source)
+	{
+		build(source);
+	}
+	~tHalfEdgeMesh()
+	{
+		release();
+	}
+	tHalfEdgeMesh(const tHalfEdgeMesh&) = delete;
+	tHalfEdgeMesh& operator=(const tHalfEdgeMesh&) = delete;
+	void build(const tShape<T>& source)
+	{
+		release();
+		shape = &source;
+		vertexCount = source.count;
+		faceCount = source.faceCount;
+		halfEdgeCount = 3 * faceCount;
+		origins = new int[halfEdgeCount];
+		twins = new int[halfEdgeCount];
+		vertexEdges = new int[vertexCount];
+		for (int i = 0; i < vertexCount; ++i)
+		{
+			vertexEdges[i] = -1;
+		}
+		for (int e = 0; e < halfEdgeCount; ++e)
+		{
+			origins[e] = source.faceVerts[e / 3].ind[e % 3];
+			if (vertexEdges[origins[e]] < 0)vertexEdges[origins[e]] = e;
+		}
+		//Directed edges sorted by their (origin, target) key, so each twin is one binary search away
+		std::vector<std::pair<uint64_t, int>> keys(halfEdgeCount);
+		for (int e = 0; e < halfEdgeCount; ++e)
+		{
+			keys[e] = std::make_pair(edgeKey(origins[e], target(e)), e);
+		}
+		std::sort(keys.begin(), keys.end());
+		closed = true;
+		for (int e = 0; e < halfEdgeCount; ++e)
+		{
+			uint64_t opposite = edgeKey(target(e), origins[e]);
+			auto match = std::lower_bound(keys.begin(), keys.end(), std::make_pair(opposite, -1));
+			twins[e] = -1;
+			if (match == keys.end() || match->first != opposite)
+			{
+				closed = false;
+				continue;
+			}
+			auto after = match + 1;
+			if (after != keys.end() && after->first == opposite)
+			{
+				closed = false;
+				continue;
+			}
+			twins[e] = match->second;
+		}
+		//On an open mesh, start each fan on a boundary so walking it reaches every face
+		//	A walk only steps onto e through e's twin, so an e without one has no face before it
+		if (!closed)
+		{
+			for (int e = 0; e < halfEdgeCount; ++e)
+			{
+				if (twins[e] < 0)vertexEdges[origins[e]] = e;
+			}
+		}
+	}
+	int origin(const int edge) const
+	{
+		return origins[edge];
+	}
+	int target(const int edge) const
+	{
+		return origins[next(edge)];
+	}
+	int twin(const int edge) const
+	{
+		return twins[edge];
+	}
+	static int next(const int edge)
+	{
+		return (edge % 3 == 2) ? edge - 2 : edge + 1;
+	}
+	static int previous(const int edge)
+	{
+		return (edge % 3 == 0) ? edge + 2 : edge - 1;
+	}
+	static int face(const int edge)
+	{
+		return edge / 3;
+	}
+	//Face across edge k of face, -1 at a boundary
+	int adjacentFace(const int faceIndex, const int k) const
+	{
+		int opposite = twins[3 * faceIndex + k];
+		return (opposite < 0) ? -1 : face(opposite);
+	}
+	//Both faces of an edge, the second is -1 at a boundary
+	std::pair<int, int> edgeFaces(const int edge) const
+	{
+		return std::make_pair(face(edge), (twins[edge] < 0) ? -1 : face(twins[edge]));
+	}
+	//Writes the faces around vertex in winding order and returns how many there are, at most capacity are written
+	int vertexFaces(const int vertex, int* out, const int capacity) const
+	{
+		int start = vertexEdges[vertex];
+		if (start < 0)return 0;
+		int found = 0;
+		int edge = start;
+		do
+		{
+			if (found < capacity)out[found] = face(edge);
+			++found;
+			//The previous half-edge ends at vertex, its twin leaves it on the next face
+			edge = twins[previous(edge)];
+		} while (edge >= 0 && edge != start);
+		return found;
+	}
+	//Face around the support vertex whose normal is furthest along direction, the reference face of a contact there
+	//	Only the vertex's fan is read, rather than every face of the mesh
+	int supportFace(const tvec3<T>& direction, const int supportVertex) const
+	{
+		int start = vertexEdges[supportVertex];
+		if (start < 0)return -1;
+		int best = face(start);
+		T magnitude = dot(shape->faces[best], direction);
+		int edge = twins[previous(start)];
+		while (edge >= 0 && edge != start)
+		{
+			T dR = dot(shape->faces[face(edge)], direction);
+			if (dR > magnitude)
+			{
+				magnitude = dR;
+				best = face(edge);
+			}
+			edge = twins[previous(edge)];
+		}
+		return best;
+	}
+	const tShape<T>& getShape() const
+	{
+		return *shape;
+	}
+	int vertexCount = 0;
+	int faceCount = 0;
+	int halfEdgeCount = 0;
+	//Every edge has a twin and no edge is shared by more than two faces
+	bool closed = false;
+	int* origins = nullptr;
+	int* twins = nullptr;
+	//One outgoing half-edge per vertex, -1 for unused vertices
+	int* vertexEdges = nullptr;
+private:
+	static uint64_t edgeKey(const int a, const int b)
+	{
+		return (static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32) | static_cast<uint32_t>(b);
+	}
+	void release()
+	{
+		if (origins != nullptr)
+		{
+			delete[] origins;
+			origins = nullptr;
+		}
+		if (twins != nullptr)
+		{
+			delete[] twins;
+			twins = nullptr;
+		}
+		if (vertexEdges != nullptr)
+		{
+			delete[] vertexEdges;
+			vertexEdges = nullptr;
+		}
+		vertexCount = faceCount = halfEdgeCount = 0;
+	}
+	const tShape<T>* shape = nullptr;
+};
+
+typedef tHalfEdgeMesh<float> HalfEdgeMesh;
+
+#endif
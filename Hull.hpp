@@ -0,0 +1,374 @@
+/*
+Purpose: Quickhull convex hull builder for collision geometry.
+	Builds the convex hull of any point set, e.g. the vertices of a concave
+		mesh, as a tShape holding only hull vertices, outward wound faces,
+		their normals and edges, and the hull's adjacency.
+	Starts from the largest tetrahedron found on the axis extremes, then
+		repeatedly adds the furthest point outside a face, replacing every
+		face that point can see with a cone of faces to the horizon.
+	Assigning points to the faces they lie outside of is the dominant cost,
+		so large batches are split into blocks over the ThreadPool with
+		dispatchJob, which hulls built at the same time take turns at.
+	Points within a relative tolerance of a face are treated as on it, so
+		coplanar input gives a triangulated hull without slivers.
+	Fewer than 4 points, or points that are all coplanar, give an empty shape.
+*/
+
+#ifndef __HULL__
+#define __HULL__
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "Arena.hpp"
+#include "ThreadPool.hpp"
+#include "VectorMath.hpp"
+#include "Shape.hpp"
+
+template <typename T>
+struct tHullFace
+{
+	int v[3];
+	int neighbor[3];//face across the edge v[i] to v[(i + 1) % 3]
+	tvec3<T> normal;
+	T offset;
+	std::vector<int> outside;//points in front of this face, each assigned to exactly one face
+	int visited = 0;
+	bool visible = false;
+	bool alive = true;
+	T distance(const tvec3<T>& p) const
+	{
+		return dot(normal, p) - offset;
+	}
+};
+
+//Assigns each candidate point to the new face it is furthest in front of, or -1 when it is inside all of them
+template <typename T>
+struct tHullAssignment
+{
+	const tvec3<T>* points = nullptr;
+	const int* candidates = nullptr;
+	int candidateCount = 0;
+	const tHullFace<T>* faces = nullptr;
+	const int* newFaces = nullptr;
+	int newFaceCount = 0;
+	T epsilon = T(0);
+	int* owner = nullptr;
+	static const int blockSize = 1024;
+	void run(unsigned int block) const
+	{
+		int end = (static_cast<int>(block) + 1) * blockSize;
+		if (end > candidateCount)end = candidateCount;
+		for (int i = static_cast<int>(block) * blockSize; i < end; ++i)
+		{
+			const tvec3<T>& p = points[candidates[i]];
+			T furthest = epsilon;
+			owner[i] = -1;
+			for (int j = 0; j < newFaceCount; ++j)
+			{
+				T d = faces[newFaces[j]].distance(p);
+				if (d > furthest)
+				{
+					furthest = d;
+					owner[i] = newFaces[j];
+				}
+			}
+		}
+	}
+	unsigned int blockCount() const
+	{
+		return static_cast<unsigned int>((candidateCount + blockSize - 1) / blockSize);
+	}
+};
+
+//Batches smaller than this are not worth a dispatch
+const int hullParallelThreshold = 8192;
+
+template <typename T>
+void assignHullPoints(tHullAssignment<T>& job, ThreadPool* pool)
+{
+	if (pool != nullptr && job.candidateCount >= hullParallelThreshold)
+	{
+		dispatchJob(*pool, job);
+		return;
+	}
+	for (unsigned int i = 0; i < job.blockCount(); ++i)
+	{
+		job.run(i);
+	}
+}
+
+template <typename T>
+int addHullFace(std::vector<tHullFace<T>>& faces, const tvec3<T>* points, int a, int b, int c)
+{
+	tHullFace<T> face;
+	face.v[0] = a;
+	face.v[1] = b;
+	face.v[2] = c;
+	face.neighbor[0] = face.neighbor[1] = face.neighbor[2] = -1;
+	tvec3<T> normal = cross(points[b] - points[a], points[c] - points[a]);
+	face.normal = normal * (T(1) / std::sqrt(dot(normal, normal)));
+	face.offset = dot(face.normal, points[a]);
+	faces.push_back(face);
+	return static_cast<int>(faces.size()) - 1;
+}
+
+template <typename T>
+tShape<T> convexHull(const tvec3<T>* source, int N, Arena* arena = nullptr, ThreadPool* pool = nullptr)
+{
+	if (N < 4)return tShape<T>();
+	//Built in double whatever the shape's precision, thin faces in single precision break convexity
+	std::vector<dvec3> input(N);
+	for (int i = 0; i < N; ++i)
+	{
+		input[i] = dvec3(source[i]);
+	}
+	const dvec3* points = input.data();
+	//Tolerance scaled to the extent of the input
+	double extent = 0.0;
+	int extremes[6] = { 0, 0, 0, 0, 0, 0 };
+	for (int i = 0; i < N; ++i)
+	{
+		const dvec3& p = points[i];
+		extent = std::fmax(extent, std::fabs(p.x) + std::fabs(p.y) + std::fabs(p.z));
+		if (p.x < points[extremes[0]].x)extremes[0] = i;
+		if (p.x > points[extremes[1]].x)extremes[1] = i;
+		if (p.y < points[extremes[2]].y)extremes[2] = i;
+		if (p.y > points[extremes[3]].y)extremes[3] = i;
+		if (p.z < points[extremes[4]].z)extremes[4] = i;
+		if (p.z > points[extremes[5]].z)extremes[5] = i;
+	}
+	const double epsilon = 48.0 * extent * std::numeric_limits<double>::epsilon();
+	//Initial tetrahedron, widest extreme pair, then furthest from their line, then furthest from that plane
+	int corner[4] = { extremes[0], extremes[1], 0, 0 };
+	double widest = -1.0;
+	for (int i = 0; i < 6; ++i)
+	{
+		for (int j = i + 1; j < 6; ++j)
+		{
+			dvec3 d = points[extremes[j]] - points[extremes[i]];
+			if (dot(d, d) > widest)
+			{
+				widest = dot(d, d);
+				corner[0] = extremes[i];
+				corner[1] = extremes[j];
+			}
+		}
+	}
+	dvec3 line = points[corner[1]] - points[corner[0]];
+	double furthest = -1.0;
+	for (int i = 0; i < N; ++i)
+	{
+		dvec3 c = cross(points[i] - points[corner[0]], line);
+		if (dot(c, c) > furthest)
+		{
+			furthest = dot(c, c);
+			corner[2] = i;
+		}
+	}
+	dvec3 planeNormal = cross(line, points[corner[2]] - points[corner[0]]);
+	double planeLength = std::sqrt(dot(planeNormal, planeNormal));
+	if (planeLength <= epsilon * std::sqrt(widest))return tShape<T>();
+	furthest = 0.0;
+	for (int i = 0; i < N; ++i)
+	{
+		double d = std::fabs(dot(points[i] - points[corner[0]], planeNormal)) / planeLength;
+		if (d > furthest)
+		{
+			furthest = d;
+			corner[3] = i;
+		}
+	}
+	if (furthest <= epsilon)return tShape<T>();
+	std::vector<tHullFace<double>> faces;
+	dvec3 centroid = (points[corner[0]] + points[corner[1]] + points[corner[2]] + points[corner[3]]) * 0.25;
+	const int tetrahedron[4][3] = { { 0, 1, 2 }, { 0, 3, 1 }, { 1, 3, 2 }, { 2, 3, 0 } };
+	for (int i = 0; i < 4; ++i)
+	{
+		int a = corner[tetrahedron[i][0]], b = corner[tetrahedron[i][1]], c = corner[tetrahedron[i][2]];
+		//Wound so the centroid is behind every face
+		if (dot(cross(points[b] - points[a], points[c] - points[a]), centroid - points[a]) > 0.0)std::swap(b, c);
+		addHullFace(faces, points, a, b, c);
+	}
+	for (int i = 0; i < 4; ++i)
+	{
+		for (int e = 0; e < 3; ++e)
+		{
+			int a = faces[i].v[e], b = faces[i].v[(e + 1) % 3];
+			for (int j = 0; j < 4; ++j)
+			{
+				for (int k = 0; k < 3; ++k)
+				{
+					if (faces[j].v[k] == b && faces[j].v[(k + 1) % 3] == a)faces[i].neighbor[e] = j;
+				}
+			}
+		}
+	}
+	std::vector<int> candidates, owner, newFaces;
+	for (int i = 0; i < N; ++i)
+	{
+		if (i != corner[0] && i != corner[1] && i != corner[2] && i != corner[3])candidates.push_back(i);
+	}
+	newFaces.assign({ 0, 1, 2, 3 });
+	tHullAssignment<double> job;
+	job.points = points;
+	job.epsilon = epsilon;
+	owner.resize(candidates.size());
+	job.candidates = candidates.data();
+	job.candidateCount = static_cast<int>(candidates.size());
+	job.faces = faces.data();
+	job.newFaces = newFaces.data();
+	job.newFaceCount = 4;
+	job.owner = owner.data();
+	assignHullPoints(job, pool);
+	for (size_t i = 0; i < candidates.size(); ++i)
+	{
+		if (owner[i] >= 0)faces[owner[i]].outside.push_back(candidates[i]);
+	}
+	//Horizon edges are linked by the vertex they start at
+	std::vector<int> horizonStart(N, -1);
+	std::vector<int> stack, visibleFaces;
+	struct HorizonEdge
+	{
+		int face, edge;
+	};
+	std::vector<HorizonEdge> horizon;
+	int stamp = 0;
+	//New faces are appended, so one pass in creation order reaches every face with outside points
+	for (size_t current = 0; current < faces.size(); ++current)
+	{
+		if (!faces[current].alive || faces[current].outside.empty())continue;
+		int eye = faces[current].outside[0];
+		double eyeDistance = faces[current].distance(points[eye]);
+		for (int p : faces[current].outside)
+		{
+			double d = faces[current].distance(points[p]);
+			if (d > eyeDistance)
+			{
+				eyeDistance = d;
+				eye = p;
+			}
+		}
+		//Flood the faces the eye can see, every edge to a face it cannot see is on the horizon
+		++stamp;
+		horizon.clear();
+		visibleFaces.clear();
+		faces[current].visited = stamp;
+		faces[current].visible = true;
+		stack.push_back(static_cast<int>(current));
+		while (!stack.empty())
+		{
+			int f = stack.back();
+			stack.pop_back();
+			visibleFaces.push_back(f);
+			for (int e = 0; e < 3; ++e)
+			{
+				int n = faces[f].neighbor[e];
+				if (faces[n].visited != stamp)
+				{
+					faces[n].visited = stamp;
+					faces[n].visible = faces[n].distance(points[eye]) > epsilon;
+					if (faces[n].visible)
+					{
+						stack.push_back(n);
+						continue;
+					}
+				}
+				if (!faces[n].visible)horizon.push_back({ f, e });
+			}
+		}
+		//Cone of new faces from the horizon to the eye
+		newFaces.clear();
+		for (const HorizonEdge& h : horizon)
+		{
+			int a = faces[h.face].v[h.edge], b = faces[h.face].v[(h.edge + 1) % 3];
+			int across = faces[h.face].neighbor[h.edge];
+			int added = addHullFace(faces, points, a, b, eye);
+			faces[added].neighbor[0] = across;
+			for (int k = 0; k < 3; ++k)
+			{
+				if (faces[across].v[k] == b && faces[across].v[(k + 1) % 3] == a)faces[across].neighbor[k] = added;
+			}
+			horizonStart[a] = added;
+			newFaces.push_back(added);
+		}
+		for (int added : newFaces)
+		{
+			//Edge (b, eye) meets the face starting at b, edge (eye, a) meets the face ending at a
+			faces[added].neighbor[1] = horizonStart[faces[added].v[1]];
+			faces[faces[added].neighbor[1]].neighbor[2] = added;
+		}
+		for (int added : newFaces)
+		{
+			horizonStart[faces[added].v[0]] = -1;
+		}
+		//Points outside the removed faces move to the new ones or are now inside
+		candidates.clear();
+		for (int f : visibleFaces)
+		{
+			for (int p : faces[f].outside)
+			{
+				if (p != eye)candidates.push_back(p);
+			}
+			faces[f].outside.clear();
+			faces[f].outside.shrink_to_fit();
+			faces[f].alive = false;
+		}
+		owner.resize(candidates.size());
+		job.candidates = candidates.data();
+		job.candidateCount = static_cast<int>(candidates.size());
+		job.faces = faces.data();
+		job.newFaces = newFaces.data();
+		job.newFaceCount = static_cast<int>(newFaces.size());
+		job.owner = owner.data();
+		assignHullPoints(job, pool);
+		for (size_t i = 0; i < candidates.size(); ++i)
+		{
+			if (owner[i] >= 0)faces[owner[i]].outside.push_back(candidates[i]);
+		}
+	}
+	//Compact the surviving faces and the vertices they use into a shape
+	std::vector<int> remap(N, -1);
+	std::vector<tvec3<T>> hullPoints;
+	int faceTotal = 0;
+	for (const tHullFace<double>& face : faces)
+	{
+		if (!face.alive)continue;
+		++faceTotal;
+		for (int k = 0; k < 3; ++k)
+		{
+			if (remap[face.v[k]] < 0)
+			{
+				remap[face.v[k]] = static_cast<int>(hullPoints.size());
+				hullPoints.push_back(source[face.v[k]]);
+			}
+		}
+	}
+	tShape<T> hull(hullPoints.data(), static_cast<int>(hullPoints.size()), arena);
+	//A closed triangulated hull always has 2 * (count - 2) faces
+	if (faceTotal < hull.faceCount)hull.faceCount = faceTotal;
+	int index = 0;
+	for (const tHullFace<double>& face : faces)
+	{
+		if (!face.alive || index == hull.faceCount)continue;
+		for (int k = 0; k < 3; ++k)
+		{
+			hull.faceVerts[index].ind[k] = remap[face.v[k]];
+		}
+		hull.faces[index] = tvec3<T>(face.normal);
+		hull.faceEdges[index].edge[0] = hull.vertices[remap[face.v[1]]] - hull.vertices[remap[face.v[0]]];
+		hull.faceEdges[index].edge[1] = hull.vertices[remap[face.v[2]]] - hull.vertices[remap[face.v[0]]];
+		++index;
+	}
+	hull.buildAdjacency();
+	return hull;
+}
+
+template <typename T>
+tShape<T> convexHull(const tShape<T>& mesh, Arena* arena = nullptr, ThreadPool* pool = nullptr)
+{
+	return convexHull(mesh.vertices, mesh.count, arena, pool);
+}
+
+#endif
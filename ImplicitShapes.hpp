@@ -0,0 +1,229 @@
+/*
+Purpose: Analytic shapes for GJK with closed form support functions.
+	A sphere, box, capsule or cylinder finds its support point in constant
+		time instead of scanning a tessellation of itself.
+	Shapes share the tImplicitShape interface through the curiously recurring
+		template pattern, so gjkDistance and gjkToI call each support
+		function directly, with nothing virtual on the hot path.
+		A derived shape provides support(direction) in its local frame and
+		getBounds(), its local box and bounding sphere.
+	Primitives have no vertices and report noFeatureID as their support id.
+	The convex hull shape scans a point cloud, but still reports the index of
+		its support point so GJK can detect repeats as it does for meshes.
+	Capsules and cylinders are aligned with the local y axis.
+*/
+
+#ifndef __IMPLICIT_SHAPES__
+#define __IMPLICIT_SHAPES__
+
+#include <cmath>
+#include <cstdint>
+#include "VectorMath.hpp"
+#include "Shape.hpp"
+
+template <typename Derived, typename T>
+class tImplicitShape
+{
+public:
+	tvec3<T> supportVertex(const tvec3<T>& direction, uint32_t& id) const
+	{
+		id = noFeatureID;
+		return static_cast<const Derived&>(*this).support(direction);
+	}
+	//Support point of the shape placed by a transform
+	tvec3<T> supportVertex(const tvec3<T>& direction, const ttransform<T>& placement, uint32_t& id) const
+	{
+		tvec3<T> local = static_cast<const Derived&>(*this).supportVertex(inverseTransformDirection(placement, direction), id);
+		return transformPoint(placement, local);
+	}
+};
+
+template <typename T>
+class tSphereShape : public tImplicitShape<tSphereShape<T>, T>
+{
+public:
+	tSphereShape()
+	{
+		//NULL
+	}
+	explicit tSphereShape(const T radius) : radius(radius)
+	{
+		//NULL
+	}
+	tvec3<T> support(const tvec3<T>& direction) const
+	{
+		T magnitude = std::sqrt(dot(direction, direction));
+		if (magnitude == T(0))return tvec3<T>(radius, T(0), T(0));
+		return direction * (radius / magnitude);
+	}
+	tBounds<T> getBounds() const
+	{
+		tBounds<T> bounds;
+		bounds.minimum = tvec3<T>(-radius);
+		bounds.maximum = tvec3<T>(radius);
+		bounds.radius = radius;
+		return bounds;
+	}
+	T radius = T(1);
+};
+
+template <typename T>
+class tBoxShape : public tImplicitShape<tBoxShape<T>, T>
+{
+public:
+	tBoxShape()
+	{
+		//NULL
+	}
+	explicit tBoxShape(const tvec3<T>& halfExtents) : halfExtents(halfExtents)
+	{
+		//NULL
+	}
+	tvec3<T> support(const tvec3<T>& direction) const
+	{
+		return tvec3<T>((direction.x < T(0)) ? -halfExtents.x : halfExtents.x,
+			(direction.y < T(0)) ? -halfExtents.y : halfExtents.y,
+			(direction.z < T(0)) ? -halfExtents.z : halfExtents.z);
+	}
+	tBounds<T> getBounds() const
+	{
+		tBounds<T> bounds;
+		bounds.minimum = T(-1) * halfExtents;
+		bounds.maximum = halfExtents;
+		bounds.radius = std::sqrt(dot(halfExtents, halfExtents));
+		return bounds;
+	}
+	tvec3<T> halfExtents = tvec3<T>(T(1));
+};
+
+template <typename T>
+class tCapsuleShape : public tImplicitShape<tCapsuleShape<T>, T>
+{
+public:
+	tCapsuleShape()
+	{
+		//NULL
+	}
+	tCapsuleShape(const T halfHeight, const T radius) : halfHeight(halfHeight), radius(radius)
+	{
+		//NULL
+	}
+	tvec3<T> support(const tvec3<T>& direction) const
+	{
+		//Sphere swept along the segment between (0, -halfHeight, 0) and (0, halfHeight, 0)
+		tvec3<T> end(T(0), (direction.y < T(0)) ? -halfHeight : halfHeight, T(0));
+		T magnitude = std::sqrt(dot(direction, direction));
+		if (magnitude == T(0))return end;
+		return end + direction * (radius / magnitude);
+	}
+	tBounds<T> getBounds() const
+	{
+		tBounds<T> bounds;
+		bounds.minimum = tvec3<T>(-radius, -halfHeight - radius, -radius);
+		bounds.maximum = tvec3<T>(radius, halfHeight + radius, radius);
+		bounds.radius = halfHeight + radius;
+		return bounds;
+	}
+	T halfHeight = T(1);
+	T radius = T(1);
+};
+
+template <typename T>
+class tCylinderShape : public tImplicitShape<tCylinderShape<T>, T>
+{
+public:
+	tCylinderShape()
+	{
+		//NULL
+	}
+	tCylinderShape(const T halfHeight, const T radius) : halfHeight(halfHeight), radius(radius)
+	{
+		//NULL
+	}
+	tvec3<T> support(const tvec3<T>& direction) const
+	{
+		//A point on the rim of the cap facing the direction
+		T y = (direction.y < T(0)) ? -halfHeight : halfHeight;
+		T radial = std::sqrt(direction.x * direction.x + direction.z * direction.z);
+		if (radial == T(0))return tvec3<T>(T(0), y, T(0));
+		T scale = radius / radial;
+		return tvec3<T>(direction.x * scale, y, direction.z * scale);
+	}
+	tBounds<T> getBounds() const
+	{
+		tBounds<T> bounds;
+		bounds.minimum = tvec3<T>(-radius, -halfHeight, -radius);
+		bounds.maximum = tvec3<T>(radius, halfHeight, radius);
+		bounds.radius = std::sqrt(halfHeight * halfHeight + radius * radius);
+		return bounds;
+	}
+	T halfHeight = T(1);
+	T radius = T(1);
+};
+
+//Points inside the hull are allowed, they are never a support point
+template <typename T>
+class tConvexHullShape : public tImplicitShape<tConvexHullShape<T>, T>
+{
+public:
+	tConvexHullShape()
+	{
+		//NULL
+	}
+	tConvexHullShape(const tvec3<T>* positions, int N)
+	{
+		count = N;
+		points = new tvec3<T>[N];
+		for (int i = 0; i < N; ++i)
+		{
+			points[i] = positions[i];
+		}
+		bounds = computeBounds(points, count);
+	}
+	~tConvexHullShape()
+	{
+		if (points != nullptr)
+		{
+			delete[] points;
+		}
+	}
+	tConvexHullShape(const tConvexHullShape&) = delete;
+	tConvexHullShape& operator=(const tConvexHullShape&) = delete;
+	using tImplicitShape<tConvexHullShape<T>, T>::supportVertex;
+	//Replaces the interface's version to report the index of the support point
+	tvec3<T> supportVertex(const tvec3<T>& direction, uint32_t& id) const
+	{
+		T magnitude = dot(points[0], direction);
+		id = 0;
+		for (int i = 1; i < count; ++i)
+		{
+			T dR = dot(points[i], direction);
+			if (dR > magnitude)
+			{
+				magnitude = dR;
+				id = i;
+			}
+		}
+		return points[id];
+	}
+	tvec3<T> support(const tvec3<T>& direction) const
+	{
+		uint32_t id = 0;
+		return supportVertex(direction, id);
+	}
+	const tBounds<T>& getBounds() const
+	{
+		return bounds;
+	}
+	int count = 0;
+	tvec3<T>* points = nullptr;
+	tBounds<T> bounds;
+};
+
+typedef tSphereShape<float> SphereShape;
+typedef tBoxShape<float> BoxShape;
+typedef tCapsuleShape<float> CapsuleShape;
+typedef tCylinderShape<float> CylinderShape;
+typedef tConvexHullShape<float> ConvexHullShape;
+
+#endif
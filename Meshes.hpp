@@ -5,348 +5,355 @@ Date Modified: 8/5/2021
 Purpose: This is just an extra application layer for generating the meshes
 		to use in this program.
 	Mesh data built and extracted from Blender via Python.
+	Blender's export order is not kept, buildHulls renumbers each mesh's hull
+		for memory locality, meshes that are never hulled keep it.
 */
 
 #ifndef __SAMPLE_MESHES__
 #define __SAMPLE_MESHES__
 
+#include <cmath>
+#include <utility>
 #include <vector>
+#include "Arena.hpp"
+#include "Hull.hpp"
+#include "ThreadPool.hpp"
 #include "VectorMath.hpp"
 #include "Shape.hpp"
 
+//Declared first so it outlives the shapes stored in it
+Arena meshArena;
 Shape cube, suzanne, sphere;
 
 void initShapes()
 {
-	vec3 verts[242];
+	vec3 sphereVerts[242], suzanneVerts[66], cubeVerts[8];
 
 	//Sphere
-	verts[0] = vec3(0.0, 0.19509032368659973, 0.9807852506637573);
-	verts[1] = vec3(0.0, 0.7071067690849304, 0.7071067690849304);
-	verts[2] = vec3(0.0, 0.8314696550369263, 0.5555701851844788);
-	verts[3] = vec3(0.0, 0.9238795042037964, 0.3826834261417389);
-	verts[4] = vec3(0.0, 0.9807852506637573, 0.19509035348892212);
-	verts[5] = vec3(0.0, 1.0, 7.549790126404332e-08);
-	verts[6] = vec3(0.0, 0.9807853102684021, -0.19509020447731018);
-	verts[7] = vec3(0.0, 0.9238795638084412, -0.38268327713012695);
-	verts[8] = vec3(0.0, 0.8314696550369263, -0.5555701851844788);
-	verts[9] = vec3(0.0, 0.7071067690849304, -0.7071067690849304);
-	verts[10] = vec3(0.0, 0.5555701851844788, -0.8314696550369263);
-	verts[11] = vec3(0.0, 0.38268327713012695, -0.9238796234130859);
-	verts[12] = vec3(0.0, 0.19509008526802063, -0.9807853102684021);
-	verts[13] = vec3(0.07465796917676926, 0.18023991584777832, 0.9807852506637573);
-	verts[14] = vec3(0.14644674956798553, 0.3535533845424652, 0.9238795042037964);
-	verts[15] = vec3(0.21260766685009003, 0.5132799744606018, 0.8314695954322815);
-	verts[16] = vec3(0.2705981731414795, 0.6532814502716064, 0.7071067690849304);
-	verts[17] = vec3(0.318189799785614, 0.7681777477264404, 0.5555701851844788);
-	verts[18] = vec3(0.35355353355407715, 0.8535533547401428, 0.3826834261417389);
-	verts[19] = vec3(0.3753304183483124, 0.906127393245697, 0.19509035348892212);
-	verts[20] = vec3(0.38268357515335083, 0.9238795042037964, 7.549790126404332e-08);
-	verts[21] = vec3(0.3753304183483124, 0.9061274528503418, -0.19509020447731018);
-	verts[22] = vec3(0.35355353355407715, 0.8535534143447876, -0.38268327713012695);
-	verts[23] = vec3(0.318189799785614, 0.7681777477264404, -0.5555701851844788);
-	verts[24] = vec3(0.2705981731414795, 0.6532814502716064, -0.7071067690849304);
-	verts[25] = vec3(0.21260763704776764, 0.513279914855957, -0.8314696550369263);
-	verts[26] = vec3(0.14644667506217957, 0.3535532057285309, -0.9238796234130859);
-	verts[27] = vec3(0.0746578723192215, 0.1802397072315216, -0.9807853102684021);
-	verts[28] = vec3(0.13794991374015808, 0.13794957101345062, 0.9807852506637573);
-	verts[29] = vec3(0.27059829235076904, 0.2705979347229004, 0.9238795042037964);
-	verts[30] = vec3(0.3928477168083191, 0.3928473889827728, 0.8314695954322815);
-	verts[31] = vec3(0.5000002384185791, 0.49999988079071045, 0.7071067690849304);
-	verts[32] = vec3(0.5879380702972412, 0.5879377126693726, 0.5555701851844788);
-	verts[33] = vec3(0.6532817482948303, 0.6532813906669617, 0.3826834261417389);
-	verts[34] = vec3(0.693520188331604, 0.6935198307037354, 0.19509035348892212);
-	verts[35] = vec3(0.7071070671081543, 0.7071067094802856, 7.549790126404332e-08);
-	verts[36] = vec3(0.693520188331604, 0.6935198307037354, -0.19509020447731018);
-	verts[37] = vec3(0.6532818078994751, 0.6532813906669617, -0.38268327713012695);
-	verts[38] = vec3(0.5879380702972412, 0.5879377126693726, -0.5555701851844788);
-	verts[39] = vec3(0.5000002384185791, 0.49999988079071045, -0.7071067690849304);
-	verts[40] = vec3(0.3928476870059967, 0.39284732937812805, -0.8314696550369263);
-	verts[41] = vec3(0.2705981731414795, 0.27059778571128845, -0.9238796234130859);
-	verts[42] = vec3(0.13794974982738495, 0.1379494071006775, -0.9807853102684021);
-	verts[43] = vec3(0.1802402287721634, 0.0746576115489006, 0.9807852506637573);
-	verts[44] = vec3(0.3535536825656891, 0.1464463621377945, 0.9238795042037964);
-	verts[45] = vec3(0.5132802724838257, 0.21260729432106018, 0.8314695954322815);
-	verts[46] = vec3(0.6532817482948303, 0.27059778571128845, 0.7071067690849304);
-	verts[47] = vec3(0.7681781053543091, 0.318189412355423, 0.5555701851844788);
-	verts[48] = vec3(0.8535537123680115, 0.3535531461238861, 0.3826834261417389);
-	verts[49] = vec3(0.9061277508735657, 0.37533003091812134, 0.19509035348892212);
-	verts[50] = vec3(0.9238799214363098, 0.3826831877231598, 7.549790126404332e-08);
-	verts[51] = vec3(0.9061277508735657, 0.37533003091812134, -0.19509020447731018);
-	verts[52] = vec3(0.8535537719726562, 0.3535531163215637, -0.38268327713012695);
-	verts[53] = vec3(0.7681781053543091, 0.318189412355423, -0.5555701851844788);
-	verts[54] = vec3(0.6532817482948303, 0.27059778571128845, -0.7071067690849304);
-	verts[55] = vec3(0.5132802128791809, 0.2126072496175766, -0.8314696550369263);
-	verts[56] = vec3(0.35355353355407715, 0.14644627273082733, -0.9238796234130859);
-	verts[57] = vec3(0.18024002015590668, 0.07465752214193344, -0.9807853102684021);
-	verts[58] = vec3(0.19509060680866241, -3.4517816516199673e-07, 0.9807852506637573);
-	verts[59] = vec3(0.38268372416496277, -3.8243106814661587e-07, 0.9238795042037964);
-	verts[60] = vec3(0.5555705428123474, -3.8243106814661587e-07, 0.8314695954322815);
-	verts[61] = vec3(0.7071070075035095, -3.9733222934046353e-07, 0.7071067690849304);
-	verts[62] = vec3(0.8314698934555054, -4.122333905343112e-07, 0.5555701851844788);
-	verts[63] = vec3(0.923879861831665, -3.8243106814661587e-07, 0.3826834261417389);
-	verts[64] = vec3(0.9807855486869812, -3.8243106814661587e-07, 0.19509035348892212);
-	verts[65] = vec3(1.0000003576278687, -4.420357129220065e-07, 7.549790126404332e-08);
-	verts[66] = vec3(0.9807855486869812, -3.8243106814661587e-07, -0.19509020447731018);
-	verts[67] = vec3(0.923879861831665, -4.420357129220065e-07, -0.38268327713012695);
-	verts[68] = vec3(0.8314698934555054, -4.122333905343112e-07, -0.5555701851844788);
-	verts[69] = vec3(0.7071070075035095, -3.9733222934046353e-07, -0.7071067690849304);
-	verts[70] = vec3(0.5555704832077026, -3.8243106814661587e-07, -0.8314696550369263);
-	verts[71] = vec3(0.38268357515335083, -3.9733222934046353e-07, -0.9238796234130859);
-	verts[72] = vec3(0.1950903832912445, -3.4517816516199673e-07, -0.9807853102684021);
-	verts[73] = vec3(0.180240198969841, -0.07465828955173492, 0.9807852506637573);
-	verts[74] = vec3(0.3535536229610443, -0.14644712209701538, 0.9238795042037964);
-	verts[75] = vec3(0.5132802128791809, -0.21260803937911987, 0.8314695954322815);
-	verts[76] = vec3(0.6532816290855408, -0.27059853076934814, 0.7071067690849304);
-	verts[77] = vec3(0.7681779265403748, -0.31819018721580505, 0.5555701851844788);
-	verts[78] = vec3(0.8535536527633667, -0.3535539209842682, 0.3826834261417389);
-	verts[79] = vec3(0.9061276912689209, -0.37533077597618103, 0.19509035348892212);
-	verts[80] = vec3(0.9238798022270203, -0.38268405199050903, 7.549790126404332e-08);
-	verts[81] = vec3(0.9061276912689209, -0.37533077597618103, -0.19509020447731018);
-	verts[82] = vec3(0.8535535931587219, -0.35355398058891296, -0.38268327713012695);
-	verts[83] = vec3(0.7681779265403748, -0.31819018721580505, -0.5555701851844788);
-	verts[84] = vec3(0.6532816290855408, -0.27059853076934814, -0.7071067690849304);
-	verts[85] = vec3(0.5132801532745361, -0.21260802447795868, -0.8314696550369263);
-	verts[86] = vec3(0.3535534739494324, -0.1464470773935318, -0.9238796234130859);
-	verts[87] = vec3(0.1802399903535843, -0.07465820759534836, -0.9807853102684021);
-	verts[88] = vec3(0.1379498541355133, -0.13795024156570435, 0.9807852506637573);
-	verts[89] = vec3(0.2705981731414795, -0.2705986201763153, 0.9238795042037964);
-	verts[90] = vec3(0.39284759759902954, -0.39284810423851013, 0.8314695954322815);
-	verts[91] = vec3(0.5000000596046448, -0.5000004768371582, 0.7071067690849304);
-	verts[92] = vec3(0.5879378318786621, -0.5879383683204651, 0.5555701851844788);
-	verts[93] = vec3(0.653281569480896, -0.653282105922699, 0.3826834261417389);
-	verts[94] = vec3(0.6935200095176697, -0.6935204863548279, 0.19509035348892212);
-	verts[95] = vec3(0.7071068286895752, -0.707107424736023, 7.549790126404332e-08);
-	verts[96] = vec3(0.6935200095176697, -0.6935204863548279, -0.19509020447731018);
-	verts[97] = vec3(0.6532815098762512, -0.653282105922699, -0.38268327713012695);
-	verts[98] = vec3(0.5879378318786621, -0.5879383683204651, -0.5555701851844788);
-	verts[99] = vec3(0.5000000596046448, -0.5000004768371582, -0.7071067690849304);
-	verts[100] = vec3(0.39284753799438477, -0.39284804463386536, -0.8314696550369263);
-	verts[101] = vec3(0.27059805393218994, -0.27059856057167053, -0.9238796234130859);
-	verts[102] = vec3(0.13794969022274017, -0.1379500776529312, -0.9807853102684021);
-	verts[103] = vec3(0.07465788722038269, -0.18024057149887085, 0.9807852506637573);
-	verts[104] = vec3(0.1464466154575348, -0.35355398058891296, 0.9238795042037964);
-	verts[105] = vec3(0.2126075029373169, -0.5132805705070496, 0.8314695954322815);
-	verts[106] = vec3(0.27059802412986755, -0.6532819271087646, 0.7071067690849304);
-	verts[107] = vec3(0.31818950176239014, -0.7681782841682434, 0.5555701851844788);
-	verts[108] = vec3(0.35355332493782043, -0.8535540103912354, 0.3826834261417389);
-	verts[109] = vec3(0.37533023953437805, -0.9061279892921448, 0.19509035348892212);
-	verts[110] = vec3(0.38268330693244934, -0.9238801002502441, 7.549790126404332e-08);
-	verts[111] = vec3(0.37533023953437805, -0.9061279892921448, -0.19509020447731018);
-	verts[112] = vec3(0.35355326533317566, -0.8535540103912354, -0.38268327713012695);
-	verts[113] = vec3(0.31818950176239014, -0.7681782841682434, -0.5555701851844788);
-	verts[114] = vec3(0.27059802412986755, -0.6532819271087646, -0.7071067690849304);
-	verts[115] = vec3(0.2126074731349945, -0.5132805109024048, -0.8314696550369263);
-	verts[116] = vec3(0.14644652605056763, -0.3535539209842682, -0.9238796234130859);
-	verts[117] = vec3(0.07465780526399612, -0.18024033308029175, -0.9807853102684021);
-	verts[118] = vec3(-6.902099869421363e-08, -0.19509093463420868, 0.9807852506637573);
-	verts[119] = vec3(-1.137244822757566e-07, -0.38268399238586426, 0.9238795042037964);
-	verts[120] = vec3(-1.435268046634519e-07, -0.5555707812309265, 0.8314695954322815);
-	verts[121] = vec3(-8.392215988806129e-08, -0.7071071863174438, 0.7071067690849304);
-	verts[122] = vec3(-2.3293377182653785e-07, -0.8314700126647949, 0.5555701851844788);
-	verts[123] = vec3(-2.0313144943884254e-07, -0.9238801002502441, 0.3826834261417389);
-	verts[124] = vec3(-1.435268046634519e-07, -0.9807857275009155, 0.19509035348892212);
-	verts[125] = vec3(-2.3293377182653785e-07, -1.0000004768371582, 7.549790126404332e-08);
-	verts[126] = vec3(-1.435268046634519e-07, -0.9807857275009155, -0.19509020447731018);
-	verts[127] = vec3(-2.6273608000337845e-07, -0.9238800406455994, -0.38268327713012695);
-	verts[128] = vec3(-2.3293377182653785e-07, -0.8314700126647949, -0.5555701851844788);
-	verts[129] = vec3(-8.392215988806129e-08, -0.7071071863174438, -0.7071067690849304);
-	verts[130] = vec3(-1.5842796585729957e-07, -0.5555707216262817, -0.8314696550369263);
-	verts[131] = vec3(-1.7332912705114722e-07, -0.3826839327812195, -0.9238796234130859);
-	verts[132] = vec3(-5.4119837500365975e-08, -0.19509068131446838, -0.9807853102684021);
-	verts[133] = vec3(0.0, -3.2584136988589307e-07, -1.0);
-	verts[134] = vec3(-0.07465801388025284, -0.18024051189422607, 0.9807852506637573);
-	verts[135] = vec3(-0.1464468240737915, -0.3535538911819458, 0.9238795042037964);
-	verts[136] = vec3(-0.2126077562570572, -0.5132803916931152, 0.8314695954322815);
-	verts[137] = vec3(-0.2705982029438019, -0.6532817482948303, 0.7071067690849304);
-	verts[138] = vec3(-0.31818991899490356, -0.7681780457496643, 0.5555701851844788);
-	verts[139] = vec3(-0.3535536825656891, -0.853553831577301, 0.3826834261417389);
-	verts[140] = vec3(-0.37533047795295715, -0.9061277508735657, 0.19509035348892212);
-	verts[141] = vec3(-0.38268372416496277, -0.923879861831665, 7.549790126404332e-08);
-	verts[142] = vec3(-0.37533047795295715, -0.9061277508735657, -0.19509020447731018);
-	verts[143] = vec3(-0.3535537123680115, -0.8535537123680115, -0.38268327713012695);
-	verts[144] = vec3(-0.31818991899490356, -0.7681780457496643, -0.5555701851844788);
-	verts[145] = vec3(-0.2705982029438019, -0.6532817482948303, -0.7071067690849304);
-	verts[146] = vec3(-0.2126077562570572, -0.5132803320884705, -0.8314696550369263);
-	verts[147] = vec3(-0.1464468538761139, -0.35355380177497864, -0.9238796234130859);
-	verts[148] = vec3(-0.07465790212154388, -0.18024030327796936, -0.9807853102684021);
-	verts[149] = vec3(-0.13794994354248047, -0.13795016705989838, 0.9807852506637573);
-	verts[150] = vec3(-0.27059832215309143, -0.270598441362381, 0.9238795042037964);
-	verts[151] = vec3(-0.3928477466106415, -0.39284777641296387, 0.8314695954322815);
-	verts[152] = vec3(-0.5000001192092896, -0.5000001192092896, 0.7071067690849304);
-	verts[153] = vec3(-0.5879380702972412, -0.5879378914833069, 0.5555701851844788);
-	verts[154] = vec3(-0.6532818078994751, -0.6532817482948303, 0.3826834261417389);
-	verts[155] = vec3(-0.6935200691223145, -0.6935200691223145, 0.19509035348892212);
-	verts[156] = vec3(-0.7071070671081543, -0.7071069478988647, 7.549790126404332e-08);
-	verts[157] = vec3(-0.6935200691223145, -0.6935200691223145, -0.19509020447731018);
-	verts[158] = vec3(-0.6532818078994751, -0.6532816290855408, -0.38268327713012695);
-	verts[159] = vec3(-0.5879380702972412, -0.5879378914833069, -0.5555701851844788);
-	verts[160] = vec3(-0.5000001192092896, -0.5000001192092896, -0.7071067690849304);
-	verts[161] = vec3(-0.3928477168083191, -0.3928477466106415, -0.8314696550369263);
-	verts[162] = vec3(-0.27059832215309143, -0.2705983519554138, -0.9238796234130859);
-	verts[163] = vec3(-0.13794976472854614, -0.13795001804828644, -0.9807853102684021);
-	verts[164] = vec3(-3.0103808512649266e-07, -4.505353956574254e-07, 1.0);
-	verts[165] = vec3(-0.18024024367332458, -0.07465819269418716, 0.9807852506637573);
-	verts[166] = vec3(-0.3535536527633667, -0.14644688367843628, 0.9238795042037964);
-	verts[167] = vec3(-0.5132802128791809, -0.21260769665241241, 0.8314695954322815);
-	verts[168] = vec3(-0.6532815098762512, -0.2705981433391571, 0.7071067690849304);
-	verts[169] = vec3(-0.7681779265403748, -0.3181895911693573, 0.5555701851844788);
-	verts[170] = vec3(-0.8535536527633667, -0.3535534739494324, 0.3826834261417389);
-	verts[171] = vec3(-0.9061274528503418, -0.3753303289413452, 0.19509035348892212);
-	verts[172] = vec3(-0.9238797426223755, -0.38268348574638367, 7.549790126404332e-08);
-	verts[173] = vec3(-0.9061274528503418, -0.3753303289413452, -0.19509020447731018);
-	verts[174] = vec3(-0.8535535931587219, -0.3535534143447876, -0.38268327713012695);
-	verts[175] = vec3(-0.7681779265403748, -0.3181895911693573, -0.5555701851844788);
-	verts[176] = vec3(-0.6532815098762512, -0.2705981433391571, -0.7071067690849304);
-	verts[177] = vec3(-0.5132801532745361, -0.21260768175125122, -0.8314696550369263);
-	verts[178] = vec3(-0.3535536229610443, -0.14644679427146912, -0.9238796234130859);
-	verts[179] = vec3(-0.18024003505706787, -0.07465813308954239, -0.9807853102684021);
-	verts[180] = vec3(-0.19509060680866241, -2.4087003680506314e-07, 0.9807852506637573);
-	verts[181] = vec3(-0.3826836347579956, -1.7381481143274868e-07, 0.9238795042037964);
-	verts[182] = vec3(-0.5555704236030579, -6.950668307581509e-08, 0.8314695954322815);
-	verts[183] = vec3(-0.7071067094802856, -8.440784426966275e-08, 0.7071067690849304);
-	verts[184] = vec3(-0.8314696550369263, 9.440609005650913e-08, 0.5555701851844788);
-	verts[185] = vec3(-0.9238796830177307, 3.4801445281118504e-08, 0.3826834261417389);
-	verts[186] = vec3(-0.9807851910591125, -5.4605521881967434e-08, 0.19509035348892212);
-	verts[187] = vec3(-1.0000001192092896, 6.460376766881382e-08, 7.549790126404332e-08);
-	verts[188] = vec3(-0.9807851910591125, -5.4605521881967434e-08, -0.19509020447731018);
-	verts[189] = vec3(-0.9238795638084412, 6.460376766881382e-08, -0.38268327713012695);
-	verts[190] = vec3(-0.8314696550369263, 9.440609005650913e-08, -0.5555701851844788);
-	verts[191] = vec3(-0.7071067094802856, -8.440784426966275e-08, -0.7071067690849304);
-	verts[192] = vec3(-0.5555703639984131, -6.950668307581509e-08, -0.8314696550369263);
-	verts[193] = vec3(-0.38268357515335083, -9.93090054635104e-08, -0.9238796234130859);
-	verts[194] = vec3(-0.1950903832912445, -2.632217785958346e-07, -0.9807853102684021);
-	verts[195] = vec3(-0.1802401840686798, 0.07465770095586777, 0.9807852506637573);
-	verts[196] = vec3(-0.35355350375175476, 0.14644649624824524, 0.9238795042037964);
-	verts[197] = vec3(-0.5132800340652466, 0.2126075178384781, 0.8314695954322815);
-	verts[198] = vec3(-0.6532813310623169, 0.2705979347229004, 0.7071067690849304);
-	verts[199] = vec3(-0.7681775689125061, 0.31818974018096924, 0.5555701851844788);
-	verts[200] = vec3(-0.8535533547401428, 0.3535534739494324, 0.3826834261417389);
-	verts[201] = vec3(-0.9061272144317627, 0.3753301799297333, 0.19509035348892212);
-	verts[202] = vec3(-0.9238795042037964, 0.38268354535102844, 7.549790126404332e-08);
-	verts[203] = vec3(-0.9061272144317627, 0.3753301799297333, -0.19509020447731018);
-	verts[204] = vec3(-0.853553295135498, 0.35355344414711, -0.38268327713012695);
-	verts[205] = vec3(-0.7681775689125061, 0.31818974018096924, -0.5555701851844788);
-	verts[206] = vec3(-0.6532813310623169, 0.2705979347229004, -0.7071067690849304);
-	verts[207] = vec3(-0.5132799744606018, 0.2126075029373169, -0.8314696550369263);
-	verts[208] = vec3(-0.3535534143447876, 0.14644655585289001, -0.9238796234130859);
-	verts[209] = vec3(-0.1802399903535843, 0.07465759664773941, -0.9807853102684021);
-	verts[210] = vec3(-0.13794982433319092, 0.1379496157169342, 0.9807852506637573);
-	verts[211] = vec3(-0.27059808373451233, 0.2705979645252228, 0.9238795042037964);
-	verts[212] = vec3(-0.3928473889827728, 0.39284747838974, 0.8314695954322815);
-	verts[213] = vec3(-0.4999997615814209, 0.4999997913837433, 0.7071067690849304);
-	verts[214] = vec3(-0.5879374146461487, 0.5879378318786621, 0.5555701851844788);
-	verts[215] = vec3(-0.6532812714576721, 0.653281569480896, 0.3826834261417389);
-	verts[216] = vec3(-0.6935195922851562, 0.6935197114944458, 0.19509035348892212);
-	verts[217] = vec3(-0.7071065902709961, 0.70710688829422, 7.549790126404332e-08);
-	verts[218] = vec3(-0.6935195922851562, 0.6935197114944458, -0.19509020447731018);
-	verts[219] = vec3(-0.6532812118530273, 0.6532815098762512, -0.38268327713012695);
-	verts[220] = vec3(-0.5879374146461487, 0.5879378318786621, -0.5555701851844788);
-	verts[221] = vec3(-0.4999997615814209, 0.4999997913837433, -0.7071067690849304);
-	verts[222] = vec3(-0.39284735918045044, 0.3928474485874176, -0.8314696550369263);
-	verts[223] = vec3(-0.2705979645252228, 0.2705979645252228, -0.9238796234130859);
-	verts[224] = vec3(-0.13794967532157898, 0.13794945180416107, -0.9807853102684021);
-	verts[225] = vec3(-0.0746578574180603, 0.18023991584777832, 0.9807852506637573);
-	verts[226] = vec3(-0.14644655585289001, 0.35355329513549805, 0.9238795042037964);
-	verts[227] = vec3(-0.21260729432106018, 0.513279914855957, 0.8314695954322815);
-	verts[228] = vec3(-0.27059775590896606, 0.6532812118530273, 0.7071067690849304);
-	verts[229] = vec3(-0.3181891441345215, 0.7681776285171509, 0.5555701851844788);
-	verts[230] = vec3(-0.35355299711227417, 0.8535534143447876, 0.3826834261417389);
-	verts[231] = vec3(-0.3753298819065094, 0.9061270952224731, 0.19509035348892212);
-	verts[232] = vec3(-0.38268303871154785, 0.9238795638084412, 7.549790126404332e-08);
-	verts[233] = vec3(-0.3753298819065094, 0.9061270952224731, -0.19509020447731018);
-	verts[234] = vec3(-0.3535529673099518, 0.853553295135498, -0.38268327713012695);
-	verts[235] = vec3(-0.3181891441345215, 0.7681776285171509, -0.5555701851844788);
-	verts[236] = vec3(-0.27059775590896606, 0.6532812118530273, -0.7071067690849304);
-	verts[237] = vec3(-0.212607279419899, 0.513279914855957, -0.8314696550369263);
-	verts[238] = vec3(-0.14644643664360046, 0.35355323553085327, -0.9238796234130859);
-	verts[239] = vec3(-0.07465777546167374, 0.1802397072315216, -0.9807853102684021);
-	verts[240] = vec3(1.544964192135012e-07, 0.38268327713012695, 0.9238795042037964);
-	verts[241] = vec3(3.333103677505278e-07, 0.555570125579834, 0.8314695954322815);
-	sphere = Shape(verts, 242);
+	sphereVerts[0] = vec3(0.0, 0.19509032368659973, 0.9807852506637573);
+	sphereVerts[1] = vec3(0.0, 0.7071067690849304, 0.7071067690849304);
+	sphereVerts[2] = vec3(0.0, 0.8314696550369263, 0.5555701851844788);
+	sphereVerts[3] = vec3(0.0, 0.9238795042037964, 0.3826834261417389);
+	sphereVerts[4] = vec3(0.0, 0.9807852506637573, 0.19509035348892212);
+	sphereVerts[5] = vec3(0.0, 1.0, 7.549790126404332e-08);
+	sphereVerts[6] = vec3(0.0, 0.9807853102684021, -0.19509020447731018);
+	sphereVerts[7] = vec3(0.0, 0.9238795638084412, -0.38268327713012695);
+	sphereVerts[8] = vec3(0.0, 0.8314696550369263, -0.5555701851844788);
+	sphereVerts[9] = vec3(0.0, 0.7071067690849304, -0.7071067690849304);
+	sphereVerts[10] = vec3(0.0, 0.5555701851844788, -0.8314696550369263);
+	sphereVerts[11] = vec3(0.0, 0.38268327713012695, -0.9238796234130859);
+	sphereVerts[12] = vec3(0.0, 0.19509008526802063, -0.9807853102684021);
+	sphereVerts[13] = vec3(0.07465796917676926, 0.18023991584777832, 0.9807852506637573);
+	sphereVerts[14] = vec3(0.14644674956798553, 0.3535533845424652, 0.9238795042037964);
+	sphereVerts[15] = vec3(0.21260766685009003, 0.5132799744606018, 0.8314695954322815);
+	sphereVerts[16] = vec3(0.2705981731414795, 0.6532814502716064, 0.7071067690849304);
+	sphereVerts[17] = vec3(0.318189799785614, 0.7681777477264404, 0.5555701851844788);
+	sphereVerts[18] = vec3(0.35355353355407715, 0.8535533547401428, 0.3826834261417389);
+	sphereVerts[19] = vec3(0.3753304183483124, 0.906127393245697, 0.19509035348892212);
+	sphereVerts[20] = vec3(0.38268357515335083, 0.9238795042037964, 7.549790126404332e-08);
+	sphereVerts[21] = vec3(0.3753304183483124, 0.9061274528503418, -0.19509020447731018);
+	sphereVerts[22] = vec3(0.35355353355407715, 0.8535534143447876, -0.38268327713012695);
+	sphereVerts[23] = vec3(0.318189799785614, 0.7681777477264404, -0.5555701851844788);
+	sphereVerts[24] = vec3(0.2705981731414795, 0.6532814502716064, -0.7071067690849304);
+	sphereVerts[25] = vec3(0.21260763704776764, 0.513279914855957, -0.8314696550369263);
+	sphereVerts[26] = vec3(0.14644667506217957, 0.3535532057285309, -0.9238796234130859);
+	sphereVerts[27] = vec3(0.0746578723192215, 0.1802397072315216, -0.9807853102684021);
+	sphereVerts[28] = vec3(0.13794991374015808, 0.13794957101345062, 0.9807852506637573);
+	sphereVerts[29] = vec3(0.27059829235076904, 0.2705979347229004, 0.9238795042037964);
+	sphereVerts[30] = vec3(0.3928477168083191, 0.3928473889827728, 0.8314695954322815);
+	sphereVerts[31] = vec3(0.5000002384185791, 0.49999988079071045, 0.7071067690849304);
+	sphereVerts[32] = vec3(0.5879380702972412, 0.5879377126693726, 0.5555701851844788);
+	sphereVerts[33] = vec3(0.6532817482948303, 0.6532813906669617, 0.3826834261417389);
+	sphereVerts[34] = vec3(0.693520188331604, 0.6935198307037354, 0.19509035348892212);
+	sphereVerts[35] = vec3(0.7071070671081543, 0.7071067094802856, 7.549790126404332e-08);
+	sphereVerts[36] = vec3(0.693520188331604, 0.6935198307037354, -0.19509020447731018);
+	sphereVerts[37] = vec3(0.6532818078994751, 0.6532813906669617, -0.38268327713012695);
+	sphereVerts[38] = vec3(0.5879380702972412, 0.5879377126693726, -0.5555701851844788);
+	sphereVerts[39] = vec3(0.5000002384185791, 0.49999988079071045, -0.7071067690849304);
+	sphereVerts[40] = vec3(0.3928476870059967, 0.39284732937812805, -0.8314696550369263);
+	sphereVerts[41] = vec3(0.2705981731414795, 0.27059778571128845, -0.9238796234130859);
+	sphereVerts[42] = vec3(0.13794974982738495, 0.1379494071006775, -0.9807853102684021);
+	sphereVerts[43] = vec3(0.1802402287721634, 0.0746576115489006, 0.9807852506637573);
+	sphereVerts[44] = vec3(0.3535536825656891, 0.1464463621377945, 0.9238795042037964);
+	sphereVerts[45] = vec3(0.5132802724838257, 0.21260729432106018, 0.8314695954322815);
+	sphereVerts[46] = vec3(0.6532817482948303, 0.27059778571128845, 0.7071067690849304);
+	sphereVerts[47] = vec3(0.7681781053543091, 0.318189412355423, 0.5555701851844788);
+	sphereVerts[48] = vec3(0.8535537123680115, 0.3535531461238861, 0.3826834261417389);
+	sphereVerts[49] = vec3(0.9061277508735657, 0.37533003091812134, 0.19509035348892212);
+	sphereVerts[50] = vec3(0.9238799214363098, 0.3826831877231598, 7.549790126404332e-08);
+	sphereVerts[51] = vec3(0.9061277508735657, 0.37533003091812134, -0.19509020447731018);
+	sphereVerts[52] = vec3(0.8535537719726562, 0.3535531163215637, -0.38268327713012695);
+	sphereVerts[53] = vec3(0.7681781053543091, 0.318189412355423, -0.5555701851844788);
+	sphereVerts[54] = vec3(0.6532817482948303, 0.27059778571128845, -0.7071067690849304);
+	sphereVerts[55] = vec3(0.5132802128791809, 0.2126072496175766, -0.8314696550369263);
+	sphereVerts[56] = vec3(0.35355353355407715, 0.14644627273082733, -0.9238796234130859);
+	sphereVerts[57] = vec3(0.18024002015590668, 0.07465752214193344, -0.9807853102684021);
+	sphereVerts[58] = vec3(0.19509060680866241, -3.4517816516199673e-07, 0.9807852506637573);
+	sphereVerts[59] = vec3(0.38268372416496277, -3.8243106814661587e-07, 0.9238795042037964);
+	sphereVerts[60] = vec3(0.5555705428123474, -3.8243106814661587e-07, 0.8314695954322815);
+	sphereVerts[61] = vec3(0.7071070075035095, -3.9733222934046353e-07, 0.7071067690849304);
+	sphereVerts[62] = vec3(0.8314698934555054, -4.122333905343112e-07, 0.5555701851844788);
+	sphereVerts[63] = vec3(0.923879861831665, -3.8243106814661587e-07, 0.3826834261417389);
+	sphereVerts[64] = vec3(0.9807855486869812, -3.8243106814661587e-07, 0.19509035348892212);
+	sphereVerts[65] = vec3(1.0000003576278687, -4.420357129220065e-07, 7.549790126404332e-08);
+	sphereVerts[66] = vec3(0.9807855486869812, -3.8243106814661587e-07, -0.19509020447731018);
+	sphereVerts[67] = vec3(0.923879861831665, -4.420357129220065e-07, -0.38268327713012695);
+	sphereVerts[68] = vec3(0.8314698934555054, -4.122333905343112e-07, -0.5555701851844788);
+	sphereVerts[69] = vec3(0.7071070075035095, -3.9733222934046353e-07, -0.7071067690849304);
+	sphereVerts[70] = vec3(0.5555704832077026, -3.8243106814661587e-07, -0.8314696550369263);
+	sphereVerts[71] = vec3(0.38268357515335083, -3.9733222934046353e-07, -0.9238796234130859);
+	sphereVerts[72] = vec3(0.1950903832912445, -3.4517816516199673e-07, -0.9807853102684021);
+	sphereVerts[73] = vec3(0.180240198969841, -0.07465828955173492, 0.9807852506637573);
+	sphereVerts[74] = vec3(0.3535536229610443, -0.14644712209701538, 0.9238795042037964);
+	sphereVerts[75] = vec3(0.5132802128791809, -0.21260803937911987, 0.8314695954322815);
+	sphereVerts[76] = vec3(0.6532816290855408, -0.27059853076934814, 0.7071067690849304);
+	sphereVerts[77] = vec3(0.7681779265403748, -0.31819018721580505, 0.5555701851844788);
+	sphereVerts[78] = vec3(0.8535536527633667, -0.3535539209842682, 0.3826834261417389);
+	sphereVerts[79] = vec3(0.9061276912689209, -0.37533077597618103, 0.19509035348892212);
+	sphereVerts[80] = vec3(0.9238798022270203, -0.38268405199050903, 7.549790126404332e-08);
+	sphereVerts[81] = vec3(0.9061276912689209, -0.37533077597618103, -0.19509020447731018);
+	sphereVerts[82] = vec3(0.8535535931587219, -0.35355398058891296, -0.38268327713012695);
+	sphereVerts[83] = vec3(0.7681779265403748, -0.31819018721580505, -0.5555701851844788);
+	sphereVerts[84] = vec3(0.6532816290855408, -0.27059853076934814, -0.7071067690849304);
+	sphereVerts[85] = vec3(0.5132801532745361, -0.21260802447795868, -0.8314696550369263);
+	sphereVerts[86] = vec3(0.3535534739494324, -0.1464470773935318, -0.9238796234130859);
+	sphereVerts[87] = vec3(0.1802399903535843, -0.07465820759534836, -0.9807853102684021);
+	sphereVerts[88] = vec3(0.1379498541355133, -0.13795024156570435, 0.9807852506637573);
+	sphereVerts[89] = vec3(0.2705981731414795, -0.2705986201763153, 0.9238795042037964);
+	sphereVerts[90] = vec3(0.39284759759902954, -0.39284810423851013, 0.8314695954322815);
+	sphereVerts[91] = vec3(0.5000000596046448, -0.5000004768371582, 0.7071067690849304);
+	sphereVerts[92] = vec3(0.5879378318786621, -0.5879383683204651, 0.5555701851844788);
+	sphereVerts[93] = vec3(0.653281569480896, -0.653282105922699, 0.3826834261417389);
+	sphereVerts[94] = vec3(0.6935200095176697, -0.6935204863548279, 0.19509035348892212);
+	sphereVerts[95] = vec3(0.7071068286895752, -0.707107424736023, 7.549790126404332e-08);
+	sphereVerts[96] = vec3(0.6935200095176697, -0.6935204863548279, -0.19509020447731018);
+	sphereVerts[97] = vec3(0.6532815098762512, -0.653282105922699, -0.38268327713012695);
+	sphereVerts[98] = vec3(0.5879378318786621, -0.5879383683204651, -0.5555701851844788);
+	sphereVerts[99] = vec3(0.5000000596046448, -0.5000004768371582, -0.7071067690849304);
+	sphereVerts[100] = vec3(0.39284753799438477, -0.39284804463386536, -0.8314696550369263);
+	sphereVerts[101] = vec3(0.27059805393218994, -0.27059856057167053, -0.9238796234130859);
+	sphereVerts[102] = vec3(0.13794969022274017, -0.1379500776529312, -0.9807853102684021);
+	sphereVerts[103] = vec3(0.07465788722038269, -0.18024057149887085, 0.9807852506637573);
+	sphereVerts[104] = vec3(0.1464466154575348, -0.35355398058891296, 0.9238795042037964);
+	sphereVerts[105] = vec3(0.2126075029373169, -0.5132805705070496, 0.8314695954322815);
+	sphereVerts[106] = vec3(0.27059802412986755, -0.6532819271087646, 0.7071067690849304);
+	sphereVerts[107] = vec3(0.31818950176239014, -0.7681782841682434, 0.5555701851844788);
+	sphereVerts[108] = vec3(0.35355332493782043, -0.8535540103912354, 0.3826834261417389);
+	sphereVerts[109] = vec3(0.37533023953437805, -0.9061279892921448, 0.19509035348892212);
+	sphereVerts[110] = vec3(0.38268330693244934, -0.9238801002502441, 7.549790126404332e-08);
+	sphereVerts[111] = vec3(0.37533023953437805, -0.9061279892921448, -0.19509020447731018);
+	sphereVerts[112] = vec3(0.35355326533317566, -0.8535540103912354, -0.38268327713012695);
+	sphereVerts[113] = vec3(0.31818950176239014, -0.7681782841682434, -0.5555701851844788);
+	sphereVerts[114] = vec3(0.27059802412986755, -0.6532819271087646, -0.7071067690849304);
+	sphereVerts[115] = vec3(0.2126074731349945, -0.5132805109024048, -0.8314696550369263);
+	sphereVerts[116] = vec3(0.14644652605056763, -0.3535539209842682, -0.9238796234130859);
+	sphereVerts[117] = vec3(0.07465780526399612, -0.18024033308029175, -0.9807853102684021);
+	sphereVerts[118] = vec3(-6.902099869421363e-08, -0.19509093463420868, 0.9807852506637573);
+	sphereVerts[119] = vec3(-1.137244822757566e-07, -0.38268399238586426, 0.9238795042037964);
+	sphereVerts[120] = vec3(-1.435268046634519e-07, -0.5555707812309265, 0.8314695954322815);
+	sphereVerts[121] = vec3(-8.392215988806129e-08, -0.7071071863174438, 0.7071067690849304);
+	sphereVerts[122] = vec3(-2.3293377182653785e-07, -0.8314700126647949, 0.5555701851844788);
+	sphereVerts[123] = vec3(-2.0313144943884254e-07, -0.9238801002502441, 0.3826834261417389);
+	sphereVerts[124] = vec3(-1.435268046634519e-07, -0.9807857275009155, 0.19509035348892212);
+	sphereVerts[125] = vec3(-2.3293377182653785e-07, -1.0000004768371582, 7.549790126404332e-08);
+	sphereVerts[126] = vec3(-1.435268046634519e-07, -0.9807857275009155, -0.19509020447731018);
+	sphereVerts[127] = vec3(-2.6273608000337845e-07, -0.9238800406455994, -0.38268327713012695);
+	sphereVerts[128] = vec3(-2.3293377182653785e-07, -0.8314700126647949, -0.5555701851844788);
+	sphereVerts[129] = vec3(-8.392215988806129e-08, -0.7071071863174438, -0.7071067690849304);
+	sphereVerts[130] = vec3(-1.5842796585729957e-07, -0.5555707216262817, -0.8314696550369263);
+	sphereVerts[131] = vec3(-1.7332912705114722e-07, -0.3826839327812195, -0.9238796234130859);
+	sphereVerts[132] = vec3(-5.4119837500365975e-08, -0.19509068131446838, -0.9807853102684021);
+	sphereVerts[133] = vec3(0.0, -3.2584136988589307e-07, -1.0);
+	sphereVerts[134] = vec3(-0.07465801388025284, -0.18024051189422607, 0.9807852506637573);
+	sphereVerts[135] = vec3(-0.1464468240737915, -0.3535538911819458, 0.9238795042037964);
+	sphereVerts[136] = vec3(-0.2126077562570572, -0.5132803916931152, 0.8314695954322815);
+	sphereVerts[137] = vec3(-0.2705982029438019, -0.6532817482948303, 0.7071067690849304);
+	sphereVerts[138] = vec3(-0.31818991899490356, -0.7681780457496643, 0.5555701851844788);
+	sphereVerts[139] = vec3(-0.3535536825656891, -0.853553831577301, 0.3826834261417389);
+	sphereVerts[140] = vec3(-0.37533047795295715, -0.9061277508735657, 0.19509035348892212);
+	sphereVerts[141] = vec3(-0.38268372416496277, -0.923879861831665, 7.549790126404332e-08);
+	sphereVerts[142] = vec3(-0.37533047795295715, -0.9061277508735657, -0.19509020447731018);
+	sphereVerts[143] = vec3(-0.3535537123680115, -0.8535537123680115, -0.38268327713012695);
+	sphereVerts[144] = vec3(-0.31818991899490356, -0.7681780457496643, -0.5555701851844788);
+	sphereVerts[145] = vec3(-0.2705982029438019, -0.6532817482948303, -0.7071067690849304);
+	sphereVerts[146] = vec3(-0.2126077562570572, -0.5132803320884705, -0.8314696550369263);
+	sphereVerts[147] = vec3(-0.1464468538761139, -0.35355380177497864, -0.9238796234130859);
+	sphereVerts[148] = vec3(-0.07465790212154388, -0.18024030327796936, -0.9807853102684021);
+	sphereVerts[149] = vec3(-0.13794994354248047, -0.13795016705989838, 0.9807852506637573);
+	sphereVerts[150] = vec3(-0.27059832215309143, -0.270598441362381, 0.9238795042037964);
+	sphereVerts[151] = vec3(-0.3928477466106415, -0.39284777641296387, 0.8314695954322815);
+	sphereVerts[152] = vec3(-0.5000001192092896, -0.5000001192092896, 0.7071067690849304);
+	sphereVerts[153] = vec3(-0.5879380702972412, -0.5879378914833069, 0.5555701851844788);
+	sphereVerts[154] = vec3(-0.6532818078994751, -0.6532817482948303, 0.3826834261417389);
+	sphereVerts[155] = vec3(-0.6935200691223145, -0.6935200691223145, 0.19509035348892212);
+	sphereVerts[156] = vec3(-0.7071070671081543, -0.7071069478988647, 7.549790126404332e-08);
+	sphereVerts[157] = vec3(-0.6935200691223145, -0.6935200691223145, -0.19509020447731018);
+	sphereVerts[158] = vec3(-0.6532818078994751, -0.6532816290855408, -0.38268327713012695);
+	sphereVerts[159] = vec3(-0.5879380702972412, -0.5879378914833069, -0.5555701851844788);
+	sphereVerts[160] = vec3(-0.5000001192092896, -0.5000001192092896, -0.7071067690849304);
+	sphereVerts[161] = vec3(-0.3928477168083191, -0.3928477466106415, -0.8314696550369263);
+	sphereVerts[162] = vec3(-0.27059832215309143, -0.2705983519554138, -0.9238796234130859);
+	sphereVerts[163] = vec3(-0.13794976472854614, -0.13795001804828644, -0.9807853102684021);
+	sphereVerts[164] = vec3(-3.0103808512649266e-07, -4.505353956574254e-07, 1.0);
+	sphereVerts[165] = vec3(-0.18024024367332458, -0.07465819269418716, 0.9807852506637573);
+	sphereVerts[166] = vec3(-0.3535536527633667, -0.14644688367843628, 0.9238795042037964);
+	sphereVerts[167] = vec3(-0.5132802128791809, -0.21260769665241241, 0.8314695954322815);
+	sphereVerts[168] = vec3(-0.6532815098762512, -0.2705981433391571, 0.7071067690849304);
+	sphereVerts[169] = vec3(-0.7681779265403748, -0.3181895911693573, 0.5555701851844788);
+	sphereVerts[170] = vec3(-0.8535536527633667, -0.3535534739494324, 0.3826834261417389);
+	sphereVerts[171] = vec3(-0.9061274528503418, -0.3753303289413452, 0.19509035348892212);
+	sphereVerts[172] = vec3(-0.9238797426223755, -0.38268348574638367, 7.549790126404332e-08);
+	sphereVerts[173] = vec3(-0.9061274528503418, -0.3753303289413452, -0.19509020447731018);
+	sphereVerts[174] = vec3(-0.8535535931587219, -0.3535534143447876, -0.38268327713012695);
+	sphereVerts[175] = vec3(-0.7681779265403748, -0.3181895911693573, -0.5555701851844788);
+	sphereVerts[176] = vec3(-0.6532815098762512, -0.2705981433391571, -0.7071067690849304);
+	sphereVerts[177] = vec3(-0.5132801532745361, -0.21260768175125122, -0.8314696550369263);
+	sphereVerts[178] = vec3(-0.3535536229610443, -0.14644679427146912, -0.9238796234130859);
+	sphereVerts[179] = vec3(-0.18024003505706787, -0.07465813308954239, -0.9807853102684021);
+	sphereVerts[180] = vec3(-0.19509060680866241, -2.4087003680506314e-07, 0.9807852506637573);
+	sphereVerts[181] = vec3(-0.3826836347579956, -1.7381481143274868e-07, 0.9238795042037964);
+	sphereVerts[182] = vec3(-0.5555704236030579, -6.950668307581509e-08, 0.8314695954322815);
+	sphereVerts[183] = vec3(-0.7071067094802856, -8.440784426966275e-08, 0.7071067690849304);
+	sphereVerts[184] = vec3(-0.8314696550369263, 9.440609005650913e-08, 0.5555701851844788);
+	sphereVerts[185] = vec3(-0.9238796830177307, 3.4801445281118504e-08, 0.3826834261417389);
+	sphereVerts[186] = vec3(-0.9807851910591125, -5.4605521881967434e-08, 0.19509035348892212);
+	sphereVerts[187] = vec3(-1.0000001192092896, 6.460376766881382e-08, 7.549790126404332e-08);
+	sphereVerts[188] = vec3(-0.9807851910591125, -5.4605521881967434e-08, -0.19509020447731018);
+	sphereVerts[189] = vec3(-0.9238795638084412, 6.460376766881382e-08, -0.38268327713012695);
+	sphereVerts[190] = vec3(-0.8314696550369263, 9.440609005650913e-08, -0.5555701851844788);
+	sphereVerts[191] = vec3(-0.7071067094802856, -8.440784426966275e-08, -0.7071067690849304);
+	sphereVerts[192] = vec3(-0.5555703639984131, -6.950668307581509e-08, -0.8314696550369263);
+	sphereVerts[193] = vec3(-0.38268357515335083, -9.93090054635104e-08, -0.9238796234130859);
+	sphereVerts[194] = vec3(-0.1950903832912445, -2.632217785958346e-07, -0.9807853102684021);
+	sphereVerts[195] = vec3(-0.1802401840686798, 0.07465770095586777, 0.9807852506637573);
+	sphereVerts[196] = vec3(-0.35355350375175476, 0.14644649624824524, 0.9238795042037964);
+	sphereVerts[197] = vec3(-0.5132800340652466, 0.2126075178384781, 0.8314695954322815);
+	sphereVerts[198] = vec3(-0.6532813310623169, 0.2705979347229004, 0.7071067690849304);
+	sphereVerts[199] = vec3(-0.7681775689125061, 0.31818974018096924, 0.5555701851844788);
+	sphereVerts[200] = vec3(-0.8535533547401428, 0.3535534739494324, 0.3826834261417389);
+	sphereVerts[201] = vec3(-0.9061272144317627, 0.3753301799297333, 0.19509035348892212);
+	sphereVerts[202] = vec3(-0.9238795042037964, 0.38268354535102844, 7.549790126404332e-08);
+	sphereVerts[203] = vec3(-0.9061272144317627, 0.3753301799297333, -0.19509020447731018);
+	sphereVerts[204] = vec3(-0.853553295135498, 0.35355344414711, -0.38268327713012695);
+	sphereVerts[205] = vec3(-0.7681775689125061, 0.31818974018096924, -0.5555701851844788);
+	sphereVerts[206] = vec3(-0.6532813310623169, 0.2705979347229004, -0.7071067690849304);
+	sphereVerts[207] = vec3(-0.5132799744606018, 0.2126075029373169, -0.8314696550369263);
+	sphereVerts[208] = vec3(-0.3535534143447876, 0.14644655585289001, -0.9238796234130859);
+	sphereVerts[209] = vec3(-0.1802399903535843, 0.07465759664773941, -0.9807853102684021);
+	sphereVerts[210] = vec3(-0.13794982433319092, 0.1379496157169342, 0.9807852506637573);
+	sphereVerts[211] = vec3(-0.27059808373451233, 0.2705979645252228, 0.9238795042037964);
+	sphereVerts[212] = vec3(-0.3928473889827728, 0.39284747838974, 0.8314695954322815);
+	sphereVerts[213] = vec3(-0.4999997615814209, 0.4999997913837433, 0.7071067690849304);
+	sphereVerts[214] = vec3(-0.5879374146461487, 0.5879378318786621, 0.5555701851844788);
+	sphereVerts[215] = vec3(-0.6532812714576721, 0.653281569480896, 0.3826834261417389);
+	sphereVerts[216] = vec3(-0.6935195922851562, 0.6935197114944458, 0.19509035348892212);
+	sphereVerts[217] = vec3(-0.7071065902709961, 0.70710688829422, 7.549790126404332e-08);
+	sphereVerts[218] = vec3(-0.6935195922851562, 0.6935197114944458, -0.19509020447731018);
+	sphereVerts[219] = vec3(-0.6532812118530273, 0.6532815098762512, -0.38268327713012695);
+	sphereVerts[220] = vec3(-0.5879374146461487, 0.5879378318786621, -0.5555701851844788);
+	sphereVerts[221] = vec3(-0.4999997615814209, 0.4999997913837433, -0.7071067690849304);
+	sphereVerts[222] = vec3(-0.39284735918045044, 0.3928474485874176, -0.8314696550369263);
+	sphereVerts[223] = vec3(-0.2705979645252228, 0.2705979645252228, -0.9238796234130859);
+	sphereVerts[224] = vec3(-0.13794967532157898, 0.13794945180416107, -0.9807853102684021);
+	sphereVerts[225] = vec3(-0.0746578574180603, 0.18023991584777832, 0.9807852506637573);
+	sphereVerts[226] = vec3(-0.14644655585289001, 0.35355329513549805, 0.9238795042037964);
+	sphereVerts[227] = vec3(-0.21260729432106018, 0.513279914855957, 0.8314695954322815);
+	sphereVerts[228] = vec3(-0.27059775590896606, 0.6532812118530273, 0.7071067690849304);
+	sphereVerts[229] = vec3(-0.3181891441345215, 0.7681776285171509, 0.5555701851844788);
+	sphereVerts[230] = vec3(-0.35355299711227417, 0.8535534143447876, 0.3826834261417389);
+	sphereVerts[231] = vec3(-0.3753298819065094, 0.9061270952224731, 0.19509035348892212);
+	sphereVerts[232] = vec3(-0.38268303871154785, 0.9238795638084412, 7.549790126404332e-08);
+	sphereVerts[233] = vec3(-0.3753298819065094, 0.9061270952224731, -0.19509020447731018);
+	sphereVerts[234] = vec3(-0.3535529673099518, 0.853553295135498, -0.38268327713012695);
+	sphereVerts[235] = vec3(-0.3181891441345215, 0.7681776285171509, -0.5555701851844788);
+	sphereVerts[236] = vec3(-0.27059775590896606, 0.6532812118530273, -0.7071067690849304);
+	sphereVerts[237] = vec3(-0.212607279419899, 0.513279914855957, -0.8314696550369263);
+	sphereVerts[238] = vec3(-0.14644643664360046, 0.35355323553085327, -0.9238796234130859);
+	sphereVerts[239] = vec3(-0.07465777546167374, 0.1802397072315216, -0.9807853102684021);
+	sphereVerts[240] = vec3(1.544964192135012e-07, 0.38268327713012695, 0.9238795042037964);
+	sphereVerts[241] = vec3(3.333103677505278e-07, 0.555570125579834, 0.8314695954322815);
 
 	//Suzanne
-	verts[0] = vec3(0.3515625, -0.828125, 0.2421875);
-	verts[1] = vec3(-0.3515625, -0.828125, 0.2421875);
-	verts[2] = vec3(0.4453125, -0.78125, 0.15625);
-	verts[3] = vec3(-0.4453125, -0.78125, 0.15625);
-	verts[4] = vec3(0.0, 0.546875, 0.8984375);
-	verts[5] = vec3(0.0, 0.8515625, 0.5625);
-	verts[6] = vec3(0.0, 0.828125, 0.0703125);
-	verts[7] = vec3(0.3671875, -0.53125, -0.890625);
-	verts[8] = vec3(-0.3671875, -0.53125, -0.890625);
-	verts[9] = vec3(0.328125, -0.5234375, -0.9453125);
-	verts[10] = vec3(-0.328125, -0.5234375, -0.9453125);
-	verts[11] = vec3(0.1796875, -0.5546875, -0.96875);
-	verts[12] = vec3(-0.1796875, -0.5546875, -0.96875);
-	verts[13] = vec3(0.0, -0.578125, -0.984375);
-	verts[14] = vec3(0.859375, -0.59375, 0.4296875);
-	verts[15] = vec3(-0.859375, -0.59375, 0.4296875);
-	verts[16] = vec3(0.3203125, -0.734375, 0.7578125);
-	verts[17] = vec3(-0.3203125, -0.734375, 0.7578125);
-	verts[18] = vec3(0.0, -0.734375, -0.765625);
-	verts[19] = vec3(0.109375, -0.734375, -0.71875);
-	verts[20] = vec3(-0.109375, -0.734375, -0.71875);
-	verts[21] = vec3(0.1171875, -0.7109375, -0.8359375);
-	verts[22] = vec3(-0.1171875, -0.7109375, -0.8359375);
-	verts[23] = vec3(0.0625, -0.6953125, -0.8828125);
-	verts[24] = vec3(-0.0625, -0.6953125, -0.8828125);
-	verts[25] = vec3(0.6875, -0.7265625, 0.4140625);
-	verts[26] = vec3(-0.6875, -0.7265625, 0.4140625);
-	verts[27] = vec3(0.3125, -0.8359375, 0.640625);
-	verts[28] = vec3(-0.3125, -0.8359375, 0.640625);
-	verts[29] = vec3(0.203125, -0.8515625, 0.6171875);
-	verts[30] = vec3(-0.203125, -0.8515625, 0.6171875);
-	verts[31] = vec3(0.265625, -0.6640625, -0.8203125);
-	verts[32] = vec3(-0.265625, -0.6640625, -0.8203125);
-	verts[33] = vec3(0.234375, -0.6328125, -0.9140625);
-	verts[34] = vec3(-0.234375, -0.6328125, -0.9140625);
-	verts[35] = vec3(0.1640625, -0.6328125, -0.9296875);
-	verts[36] = vec3(-0.1640625, -0.6328125, -0.9296875);
-	verts[37] = vec3(0.0, -0.640625, -0.9453125);
-	verts[38] = vec3(0.109375, -0.828125, -0.2265625);
-	verts[39] = vec3(-0.109375, -0.828125, -0.2265625);
-	verts[40] = vec3(0.0, -0.2890625, 0.8984375);
-	verts[41] = vec3(0.0, 0.078125, 0.984375);
-	verts[42] = vec3(0.0, 0.671875, -0.1953125);
-	verts[43] = vec3(0.0, -0.4609375, -0.9765625);
-	verts[44] = vec3(0.328125, -0.3984375, -0.9140625);
-	verts[45] = vec3(-0.328125, -0.3984375, -0.9140625);
-	verts[46] = vec3(0.453125, 0.3828125, 0.8671875);
-	verts[47] = vec3(-0.453125, 0.3828125, 0.8671875);
-	verts[48] = vec3(0.453125, 0.0703125, 0.9296875);
-	verts[49] = vec3(-0.453125, 0.0703125, 0.9296875);
-	verts[50] = vec3(0.453125, -0.234375, 0.8515625);
-	verts[51] = vec3(-0.453125, -0.234375, 0.8515625);
-	verts[52] = vec3(1.28125, 0.4296875, 0.0546875);
-	verts[53] = vec3(-1.28125, 0.4296875, 0.0546875);
-	verts[54] = vec3(1.3515625, 0.421875, 0.3203125);
-	verts[55] = vec3(-1.3515625, 0.421875, 0.3203125);
-	verts[56] = vec3(1.234375, 0.421875, 0.5078125);
-	verts[57] = vec3(-1.234375, 0.421875, 0.5078125);
-	verts[58] = vec3(1.25, 0.546875, 0.46875);
-	verts[59] = vec3(-1.25, 0.546875, 0.46875);
-	verts[60] = vec3(1.3671875, 0.5, 0.296875);
-	verts[61] = vec3(-1.3671875, 0.5, 0.296875);
-	verts[62] = vec3(1.3125, 0.53125, 0.0546875);
-	verts[63] = vec3(-1.3125, 0.53125, 0.0546875);
-	verts[64] = vec3(1.0390625, 0.4921875, -0.0859375);
-	verts[65] = vec3(-1.0390625, 0.4921875, -0.0859375);
-	suzanne = Shape(verts, 66);
+	suzanneVerts[0] = vec3(0.3515625, -0.828125, 0.2421875);
+	suzanneVerts[1] = vec3(-0.3515625, -0.828125, 0.2421875);
+	suzanneVerts[2] = vec3(0.4453125, -0.78125, 0.15625);
+	suzanneVerts[3] = vec3(-0.4453125, -0.78125, 0.15625);
+	suzanneVerts[4] = vec3(0.0, 0.546875, 0.8984375);
+	suzanneVerts[5] = vec3(0.0, 0.8515625, 0.5625);
+	suzanneVerts[6] = vec3(0.0, 0.828125, 0.0703125);
+	suzanneVerts[7] = vec3(0.3671875, -0.53125, -0.890625);
+	suzanneVerts[8] = vec3(-0.3671875, -0.53125, -0.890625);
+	suzanneVerts[9] = vec3(0.328125, -0.5234375, -0.9453125);
+	suzanneVerts[10] = vec3(-0.328125, -0.5234375, -0.9453125);
+	suzanneVerts[11] = vec3(0.1796875, -0.5546875, -0.96875);
+	suzanneVerts[12] = vec3(-0.1796875, -0.5546875, -0.96875);
+	suzanneVerts[13] = vec3(0.0, -0.578125, -0.984375);
+	suzanneVerts[14] = vec3(0.859375, -0.59375, 0.4296875);
+	suzanneVerts[15] = vec3(-0.859375, -0.59375, 0.4296875);
+	suzanneVerts[16] = vec3(0.3203125, -0.734375, 0.7578125);
+	suzanneVerts[17] = vec3(-0.3203125, -0.734375, 0.7578125);
+	suzanneVerts[18] = vec3(0.0, -0.734375, -0.765625);
+	suzanneVerts[19] = vec3(0.109375, -0.734375, -0.71875);
+	suzanneVerts[20] = vec3(-0.109375, -0.734375, -0.71875);
+	suzanneVerts[21] = vec3(0.1171875, -0.7109375, -0.8359375);
+	suzanneVerts[22] = vec3(-0.1171875, -0.7109375, -0.8359375);
+	suzanneVerts[23] = vec3(0.0625, -0.6953125, -0.8828125);
+	suzanneVerts[24] = vec3(-0.0625, -0.6953125, -0.8828125);
+	suzanneVerts[25] = vec3(0.6875, -0.7265625, 0.4140625);
+	suzanneVerts[26] = vec3(-0.6875, -0.7265625, 0.4140625);
+	suzanneVerts[27] = vec3(0.3125, -0.8359375, 0.640625);
+	suzanneVerts[28] = vec3(-0.3125, -0.8359375, 0.640625);
+	suzanneVerts[29] = vec3(0.203125, -0.8515625, 0.6171875);
+	suzanneVerts[30] = vec3(-0.203125, -0.8515625, 0.6171875);
+	suzanneVerts[31] = vec3(0.265625, -0.6640625, -0.8203125);
+	suzanneVerts[32] = vec3(-0.265625, -0.6640625, -0.8203125);
+	suzanneVerts[33] = vec3(0.234375, -0.6328125, -0.9140625);
+	suzanneVerts[34] = vec3(-0.234375, -0.6328125, -0.9140625);
+	suzanneVerts[35] = vec3(0.1640625, -0.6328125, -0.9296875);
+	suzanneVerts[36] = vec3(-0.1640625, -0.6328125, -0.9296875);
+	suzanneVerts[37] = vec3(0.0, -0.640625, -0.9453125);
+	suzanneVerts[38] = vec3(0.109375, -0.828125, -0.2265625);
+	suzanneVerts[39] = vec3(-0.109375, -0.828125, -0.2265625);
+	suzanneVerts[40] = vec3(0.0, -0.2890625, 0.8984375);
+	suzanneVerts[41] = vec3(0.0, 0.078125, 0.984375);
+	suzanneVerts[42] = vec3(0.0, 0.671875, -0.1953125);
+	suzanneVerts[43] = vec3(0.0, -0.4609375, -0.9765625);
+	suzanneVerts[44] = vec3(0.328125, -0.3984375, -0.9140625);
+	suzanneVerts[45] = vec3(-0.328125, -0.3984375, -0.9140625);
+	suzanneVerts[46] = vec3(0.453125, 0.3828125, 0.8671875);
+	suzanneVerts[47] = vec3(-0.453125, 0.3828125, 0.8671875);
+	suzanneVerts[48] = vec3(0.453125, 0.0703125, 0.9296875);
+	suzanneVerts[49] = vec3(-0.453125, 0.0703125, 0.9296875);
+	suzanneVerts[50] = vec3(0.453125, -0.234375, 0.8515625);
+	suzanneVerts[51] = vec3(-0.453125, -0.234375, 0.8515625);
+	suzanneVerts[52] = vec3(1.28125, 0.4296875, 0.0546875);
+	suzanneVerts[53] = vec3(-1.28125, 0.4296875, 0.0546875);
+	suzanneVerts[54] = vec3(1.3515625, 0.421875, 0.3203125);
+	suzanneVerts[55] = vec3(-1.3515625, 0.421875, 0.3203125);
+	suzanneVerts[56] = vec3(1.234375, 0.421875, 0.5078125);
+	suzanneVerts[57] = vec3(-1.234375, 0.421875, 0.5078125);
+	suzanneVerts[58] = vec3(1.25, 0.546875, 0.46875);
+	suzanneVerts[59] = vec3(-1.25, 0.546875, 0.46875);
+	suzanneVerts[60] = vec3(1.3671875, 0.5, 0.296875);
+	suzanneVerts[61] = vec3(-1.3671875, 0.5, 0.296875);
+	suzanneVerts[62] = vec3(1.3125, 0.53125, 0.0546875);
+	suzanneVerts[63] = vec3(-1.3125, 0.53125, 0.0546875);
+	suzanneVerts[64] = vec3(1.0390625, 0.4921875, -0.0859375);
+	suzanneVerts[65] = vec3(-1.0390625, 0.4921875, -0.0859375);
 
 	//Cube
-	verts[0] = (vec3(-1.0f, -1.0f, -1.0f));//0
-	verts[1] = (vec3(1.0f, -1.0f, -1.0f));//1
-	verts[2] = (vec3(1.0f, -1.0f, 1.0f));//2
-	verts[3] = (vec3(-1.0f, -1.0f, 1.0f));//3
-	verts[4] = (vec3(-1.0f, 1.0f, -1.0f));//4
-	verts[5] = (vec3(1.0f, 1.0f, -1.0f));//5
-	verts[6] = (vec3(1.0f, 1.0f, 1.0f));//6
-	verts[7] = (vec3(-1.0f, 1.0f, 1.0f));//7
-	cube = Shape(verts, 8);
+	cubeVerts[0] = (vec3(-1.0f, -1.0f, -1.0f));//0
+	cubeVerts[1] = (vec3(1.0f, -1.0f, -1.0f));//1
+	cubeVerts[2] = (vec3(1.0f, -1.0f, 1.0f));//2
+	cubeVerts[3] = (vec3(-1.0f, -1.0f, 1.0f));//3
+	cubeVerts[4] = (vec3(-1.0f, 1.0f, -1.0f));//4
+	cubeVerts[5] = (vec3(1.0f, 1.0f, -1.0f));//5
+	cubeVerts[6] = (vec3(1.0f, 1.0f, 1.0f));//6
+	cubeVerts[7] = (vec3(-1.0f, 1.0f, 1.0f));//7
 
 	//Push the static Sphere edge data to each Shape
 	int edge[242];
+	int sphereValence[242], suzanneValence[66], cubeValence[8];
 	edge[0] = 4;
 	edge[1] = 4;
 	edge[2] = 4;
@@ -591,7 +598,7 @@ void initShapes()
 	edge[241] = 4;
 	for (unsigned int i = 0; i < 242; ++i)//Set the edge counts first so that edge paths can be correctly iterated over
 	{
-		sphere.edgeCount[i] = edge[i];
+		sphereValence[i] = edge[i];
 	}
 	edge[0] = 5;
 	edge[1] = 4;
@@ -603,7 +610,7 @@ void initShapes()
 	edge[7] = 5;
 	for (unsigned int i = 0; i < 8; ++i)//Set the edge counts first so that edge paths can be correctly iterated over
 	{
-		cube.edgeCount[i] = edge[i];
+		cubeValence[i] = edge[i];
 	}
 	//End Sphere Edge
 	//Suzanne Edge (Count)
@@ -676,7 +683,7 @@ void initShapes()
 	//Suzanne End Edge (Count)
 	for (unsigned int i = 0; i < 66; ++i)//Set the edge counts first so that edge paths can be correctly iterated over
 	{
-		suzanne.edgeCount[i] = edge[i];
+		suzanneValence[i] = edge[i];
 	}
 
 	int edgeV[242][16];
@@ -716,16 +723,7 @@ void initShapes()
 	edgeV[7][2] = 6;
 	edgeV[7][3] = 2;
 	edgeV[7][4] = 3;
-	for (unsigned int i = 0; i < 8; ++i)
-	{
-		for (unsigned int j = 0; j < cube.edgeCount[i]; ++j)
-		{
-			cube.edges[i][j] = edgeV[i][j];
-			//Flattened indexing as well
-			int index = i * 16 + j;
-			cube.edgeAlt[index] = edgeV[i][j];
-		}
-	}
+	cube = Shape(cubeVerts, 8, cubeValence, edgeV, &meshArena);
 
 	//Sphere EdgeV
 	edgeV[1][0] = 2;
@@ -1720,16 +1718,7 @@ void initShapes()
 	edgeV[233][3] = 6;
 	edgeV[7][3] = 234;
 	edgeV[234][3] = 7;
-	for (unsigned int i = 0; i < 242; ++i)
-	{
-		for (unsigned int j = 0; j < sphere.edgeCount[i]; ++j)
-		{
-			sphere.edges[i][j] = edgeV[i][j];
-			//Flattened indexing as well
-			int index = i * 16 + j;
-			sphere.edgeAlt[index] = edgeV[i][j];
-		}
-	}
+	sphere = Shape(sphereVerts, 242, sphereValence, edgeV, &meshArena);
 	//End Sphere EdgeV
 	//Suzanne EdgeV
 	edgeV[0][0] = 2;
@@ -2071,16 +2060,7 @@ void initShapes()
 	edgeV[14][7] = 54;
 	edgeV[54][3] = 14;
 	//End Suzanne EdgeV
-	for (unsigned int i = 0; i < 66; ++i)
-	{
-		for (unsigned int j = 0; j < suzanne.edgeCount[i]; ++j)
-		{
-			suzanne.edges[i][j] = edgeV[i][j];
-			//Flattened indexing as well
-			int index = i * 16 + j;
-			suzanne.edgeAlt[index] = edgeV[i][j];
-		}
-	}
+	suzanne = Shape(suzanneVerts, 66, suzanneValence, edgeV, &meshArena);
 }
 
 void buildFaces()
@@ -2135,6 +2115,7 @@ void buildFaces()
 		cube.faceEdges[i].edge[0] = A;
 		cube.faceEdges[i].edge[1] = B;
 	}
+	cube.buildAdjacency();
 
 	fV[0].ind[0] = 4;
 	fV[0].ind[1] = 5;
@@ -3589,6 +3570,7 @@ void buildFaces()
 		sphere.faceEdges[i].edge[0] = A;
 		sphere.faceEdges[i].edge[1] = B;
 	}
+	sphere.buildAdjacency();
 
 	fV[0].ind[0] = 35;
 	fV[0].ind[1] = 11;
@@ -3987,7 +3969,95 @@ void buildFaces()
 		suzanne.faceEdges[i].edge[0] = A;
 		suzanne.faceEdges[i].edge[1] = B;
 	}
+	suzanne.buildAdjacency();
+
+}
+
+//Replaces each mesh with its convex hull, so support scans only visit hull vertices and face tests only hull faces
+//	The hull faces also replace the authored ones, which are not all on the surface (the cube has interior diagonals)
+void buildHulls(ThreadPool* pool = nullptr)
+{
+	cube = convexHull(cube, &meshArena, pool);
+	suzanne = convexHull(suzanne, &meshArena, pool);
+	sphere = convexHull(sphere, &meshArena, pool);
+	cube.reorderForLocality();
+	suzanne.reorderForLocality();
+	sphere.reorderForLocality();
+}
+
+//Stores face index as triangle a, b, c, wound counterclockwise seen from outside a shape centered on the origin
+void setOutwardFace(Shape& shape, int index, int a, int b, int c)
+{
+	vec3 A = shape.vertices[b] - shape.vertices[a];
+	vec3 B = shape.vertices[c] - shape.vertices[a];
+	vec3 normal = cross(A, B);
+	if (dot(normal, shape.vertices[a]) < 0.0f)
+	{
+		std::swap(b, c);
+		std::swap(A, B);
+		normal = -1.0f * normal;
+	}
+	shape.faceVerts[index].ind[0] = a;
+	shape.faceVerts[index].ind[1] = b;
+	shape.faceVerts[index].ind[2] = c;
+	shape.faces[index] = normalize(normal);
+	shape.faceEdges[index].edge[0] = A;
+	shape.faceEdges[index].edge[1] = B;
+}
+
+//UV sphere of unit radius with segments * rings + 2 vertices, for scaling trials past the stored meshes
+//	The pole vertices have a valence of segments
+Shape refinedSphere(int segments, int rings, Arena* arena = nullptr)
+{
+	const float pi = 3.14159265358979f;
+	int N = segments * rings + 2;
+	std::vector<vec3> positions(N);
+	positions[0] = vec3(0.0f, 1.0f, 0.0f);
+	positions[N - 1] = vec3(0.0f, -1.0f, 0.0f);
+	for (int r = 0; r < rings; ++r)
+	{
+		float theta = pi * static_cast<float>(r + 1) / static_cast<float>(rings + 1);
+		for (int s = 0; s < segments; ++s)
+		{
+			float phi = 2.0f * pi * static_cast<float>(s) / static_cast<float>(segments);
+			positions[1 + r * segments + s] = vec3(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+		}
+	}
+	Shape shape(positions.data(), N, arena);
+	int face = 0;
+	for (int s = 0; s < segments; ++s)
+	{
+		int next = (s + 1) % segments;
+		setOutwardFace(shape, face++, 0, 1 + s, 1 + next);
+		setOutwardFace(shape, face++, N - 1, 1 + (rings - 1) * segments + next, 1 + (rings - 1) * segments + s);
+		for (int r = 0; r + 1 < rings; ++r)
+		{
+			int upper = 1 + r * segments, lower = upper + segments;
+			setOutwardFace(shape, face++, upper + s, lower + s, lower + next);
+			setOutwardFace(shape, face++, upper + s, lower + next, upper + next);
+		}
+	}
+	shape.buildAdjacency();
+	return shape;
+}
 
+//Refined sphere pinched into two lobes joined by a narrow neck along y, a concave mesh for decomposition trials
+//	Radial scale runs from 0.3 at the neck and poles to 1 at the middle of each lobe, and the mesh is stretched to a height of 4
+Shape refinedDumbbell(int segments, int rings, Arena* arena = nullptr)
+{
+	Shape shape = refinedSphere(segments, rings, arena);
+	for (int i = 0; i < shape.count; ++i)
+	{
+		vec3 p = shape.vertices[i];
+		//|sin(2 * theta)| from y = cos(theta)
+		float lobe = 2.0f * std::fabs(p.y) * std::sqrt(std::fmax(0.0f, 1.0f - p.y * p.y));
+		float radial = 0.3f + 0.7f * lobe;
+		shape.moveVertex(i, vec3(p.x * radial, 2.0f * p.y, p.z * radial));
+	}
+	shape.updateFaces();
+	shape.updateBounds();
+	shape.buildAdjacency();
+	return shape;
 }
 
 #endif
\ No newline at end of file
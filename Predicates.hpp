@@ -0,0 +1,231 @@
+/*
+Purpose: Floating point filtered orientation predicates.
+	Following Shewchuk's "Adaptive Precision Floating-Point Arithmetic and
+		Fast Robust Geometric Predicates" (1997).
+	orient2d and orient3d first evaluate the determinant in working precision
+		and accept its sign when the magnitude clears a forward error bound.
+		Only inputs that are (nearly) degenerate fall through to an exact
+		evaluation with expansion arithmetic, so the common case costs a
+		handful of extra absolute values and one comparison.
+	The returned value always has the exact sign of the determinant, but is
+		only an approximation of its magnitude.
+	Works for float and double, assuming no overflow or underflow.
+*/
+
+#ifndef __PREDICATES__
+#define __PREDICATES__
+
+#include <cmath>
+#include <limits>
+
+//Exact sum a + b = x + y, x is the rounded sum
+template <typename T>
+void twoSum(const T a, const T b, T& x, T& y)
+{
+	x = a + b;
+	T bVirtual = x - a;
+	T aVirtual = x - bVirtual;
+	y = (a - aVirtual) + (b - bVirtual);
+}
+
+//Exact difference a - b = x + y, x is the rounded difference
+template <typename T>
+void twoDiff(const T a, const T b, T& x, T& y)
+{
+	x = a - b;
+	T bVirtual = a - x;
+	T aVirtual = x + bVirtual;
+	y = (a - aVirtual) + (bVirtual - b);
+}
+
+//Exact product a * b = x + y, the fused multiply add recovers the rounding error
+template <typename T>
+void twoProduct(const T a, const T b, T& x, T& y)
+{
+	x = a * b;
+	y = std::fma(a, b, -x);
+}
+
+//h = e + b, zero components removed, returns the length of h (h may alias e)
+template <typename T>
+int growExpansion(const int eLength, const T* e, const T b, T* h)
+{
+	T Q = b, hNow;
+	int hIndex = 0;
+	for (int i = 0; i < eLength; ++i)
+	{
+		twoSum(Q, e[i], Q, hNow);
+		if (hNow != T(0))h[hIndex++] = hNow;
+	}
+	if (Q != T(0) || hIndex == 0)h[hIndex++] = Q;
+	return hIndex;
+}
+
+//h = e + f, h must be able to hold eLength + fLength components and must not alias f
+template <typename T>
+int expansionSum(const int eLength, const T* e, const int fLength, const T* f, T* h)
+{
+	for (int i = 0; i < eLength; ++i)
+	{
+		h[i] = e[i];
+	}
+	int hLength = eLength;
+	for (int i = 0; i < fLength; ++i)
+	{
+		hLength = growExpansion(hLength, h, f[i], h);
+	}
+	return hLength;
+}
+
+//h = e * b, h must be able to hold 2 * eLength components
+template <typename T>
+int scaleExpansion(const int eLength, const T* e, const T b, T* h)
+{
+	T Q, sum, hNow, product1, product0;
+	int hIndex = 0;
+	twoProduct(e[0], b, Q, hNow);
+	if (hNow != T(0))h[hIndex++] = hNow;
+	for (int i = 1; i < eLength; ++i)
+	{
+		twoProduct(e[i], b, product1, product0);
+		twoSum(Q, product0, sum, hNow);
+		if (hNow != T(0))h[hIndex++] = hNow;
+		twoSum(product1, sum, Q, hNow);
+		if (hNow != T(0))h[hIndex++] = hNow;
+	}
+	if (Q != T(0) || hIndex == 0)h[hIndex++] = Q;
+	return hIndex;
+}
+
+//h = e * f, h must be able to hold 2 * eLength * fLength components
+template <typename T>
+int expansionProduct(const int eLength, const T* e, const int fLength, const T* f, T* h)
+{
+	T partial[64], sum[192];
+	int hLength = 0;
+	for (int i = 0; i < fLength; ++i)
+	{
+		int partialLength = scaleExpansion(eLength, e, f[i], partial);
+		hLength = expansionSum(hLength, h, partialLength, partial, sum);
+		for (int j = 0; j < hLength; ++j)
+		{
+			h[j] = sum[j];
+		}
+	}
+	return hLength;
+}
+
+//Components are ordered by increasing magnitude, so the last one carries the sign
+template <typename T>
+T expansionEstimate(const int eLength, const T* e)
+{
+	T sum = T(0);
+	for (int i = 0; i < eLength; ++i)
+	{
+		sum += e[i];
+	}
+	//A rounded sum can only lose the sign when it cancels to zero
+	return (sum != T(0)) ? sum : e[eLength - 1];
+}
+
+template <typename T>
+T orient2dExact(const T ax, const T ay, const T bx, const T by, const T cx, const T cy)
+{
+	//(a - c) x (b - c) with every difference kept as a two component expansion
+	T acx[2], acy[2], bcx[2], bcy[2];
+	twoDiff(ax, cx, acx[1], acx[0]);
+	twoDiff(ay, cy, acy[1], acy[0]);
+	twoDiff(bx, cx, bcx[1], bcx[0]);
+	twoDiff(by, cy, bcy[1], bcy[0]);
+	T left[8], right[8], det[16];
+	int leftLength = expansionProduct(2, acx, 2, bcy, left);
+	int rightLength = expansionProduct(2, acy, 2, bcx, right);
+	for (int i = 0; i < rightLength; ++i)
+	{
+		right[i] = -right[i];
+	}
+	int detLength = expansionSum(leftLength, left, rightLength, right, det);
+	return expansionEstimate(detLength, det);
+}
+
+//Positive when a, b, c are in counterclockwise order, negative when clockwise, zero when collinear
+template <typename T>
+T orient2d(const T ax, const T ay, const T bx, const T by, const T cx, const T cy)
+{
+	const T epsilon = std::numeric_limits<T>::epsilon() * T(0.5);
+	const T errorBound = (T(3) + T(16) * epsilon) * epsilon;
+	T detLeft = (ax - cx) * (by - cy);
+	T detRight = (ay - cy) * (bx - cx);
+	T det = detLeft - detRight;
+	T detSum = std::fabs(detLeft) + std::fabs(detRight);
+	if (std::fabs(det) > errorBound * detSum || detSum == T(0))
+	{
+		return det;
+	}
+	return orient2dExact(ax, ay, bx, by, cx, cy);
+}
+
+template <typename T>
+T orient3dExact(const T ax, const T ay, const T az, const T bx, const T by, const T bz,
+	const T cx, const T cy, const T cz, const T dx, const T dy, const T dz)
+{
+	T adx[2], ady[2], adz[2], bdx[2], bdy[2], bdz[2], cdx[2], cdy[2], cdz[2];
+	twoDiff(ax, dx, adx[1], adx[0]);
+	twoDiff(ay, dy, ady[1], ady[0]);
+	twoDiff(az, dz, adz[1], adz[0]);
+	twoDiff(bx, dx, bdx[1], bdx[0]);
+	twoDiff(by, dy, bdy[1], bdy[0]);
+	twoDiff(bz, dz, bdz[1], bdz[0]);
+	twoDiff(cx, dx, cdx[1], cdx[0]);
+	twoDiff(cy, dy, cdy[1], cdy[0]);
+	twoDiff(cz, dz, cdz[1], cdz[0]);
+	//det = adz * (bdx * cdy - cdx * bdy) + bdz * (cdx * ady - adx * cdy) + cdz * (adx * bdy - bdx * ady)
+	const T* minors[3][4] = { { bdx, cdy, cdx, bdy }, { cdx, ady, adx, cdy }, { adx, bdy, bdx, ady } };
+	const T* scales[3] = { adz, bdz, cdz };
+	T left[8], right[8], minor[16], term[64], sum[192], det[192];
+	int detLength = 0;
+	for (int i = 0; i < 3; ++i)
+	{
+		int leftLength = expansionProduct(2, minors[i][0], 2, minors[i][1], left);
+		int rightLength = expansionProduct(2, minors[i][2], 2, minors[i][3], right);
+		for (int j = 0; j < rightLength; ++j)
+		{
+			right[j] = -right[j];
+		}
+		int minorLength = expansionSum(leftLength, left, rightLength, right, minor);
+		int termLength = expansionProduct(minorLength, minor, 2, scales[i], term);
+		detLength = expansionSum(detLength, det, termLength, term, sum);
+		for (int j = 0; j < detLength; ++j)
+		{
+			det[j] = sum[j];
+		}
+	}
+	return expansionEstimate(detLength, det);
+}
+
+//Positive when d lies below the plane through a, b, c (a, b, c counterclockwise seen from above),
+//	negative when above, zero when coplanar
+template <typename T>
+T orient3d(const T ax, const T ay, const T az, const T bx, const T by, const T bz,
+	const T cx, const T cy, const T cz, const T dx, const T dy, const T dz)
+{
+	const T epsilon = std::numeric_limits<T>::epsilon() * T(0.5);
+	const T errorBound = (T(7) + T(56) * epsilon) * epsilon;
+	T adx = ax - dx, ady = ay - dy, adz = az - dz;
+	T bdx = bx - dx, bdy = by - dy, bdz = bz - dz;
+	T cdx = cx - dx, cdy = cy - dy, cdz = cz - dz;
+	T bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+	T cdxady = cdx * ady, adxcdy = adx * cdy;
+	T adxbdy = adx * bdy, bdxady = bdx * ady;
+	T det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+	T permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * std::fabs(adz)
+		+ (std::fabs(cdxady) + std::fabs(adxcdy)) * std::fabs(bdz)
+		+ (std::fabs(adxbdy) + std::fabs(bdxady)) * std::fabs(cdz);
+	if (std::fabs(det) > errorBound * permanent || permanent == T(0))
+	{
+		return det;
+	}
+	return orient3dExact(ax, ay, az, bx, by, bz, cx, cy, cz, dx, dy, dz);
+}
+
+#endif
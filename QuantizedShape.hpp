@@ -0,0 +1,169 @@
+/*
+Purpose: Compressed vertex storage for scenes with many bodies.
+	Vertices are stored as 16 bit coordinates relative to the shape's
+		axis aligned bounding box, 6 bytes per vertex instead of 12 for
+		single precision, which halves the memory traffic of support scans.
+	Support queries run on the quantized values directly.
+		dot(origin + scale * q, d) only differs from dot(q, scale * d) by
+		a constant, so the scan never dequantizes a vertex.
+	Dequantized vertices are within errorBound() of the source mesh, so a
+		distance found between two quantized shapes is conservative once
+		both bounds are subtracted from it.
+*/
+
+#ifndef __QUANTIZED_SHAPE__
+#define __QUANTIZED_SHAPE__
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include "VectorMath.hpp"
+#include "Shape.hpp"
+
+struct QuantizedVertex
+{
+	uint16_t x, y, z;
+};
+
+template <typename T>
+class tQuantizedShape
+{
+public:
+	tQuantizedShape()
+	{
+		//NULL
+	}
+	explicit tQuantizedShape(const tShape<T>& source)
+	{
+		quantize(source);
+	}
+	~tQuantizedShape()
+	{
+		if (vertices != nullptr)
+		{
+			delete[] vertices;
+		}
+		if (faceVerts != nullptr)
+		{
+			delete[] faceVerts;
+		}
+	}
+	tQuantizedShape(const tQuantizedShape&) = delete;
+	tQuantizedShape& operator=(const tQuantizedShape&) = delete;
+	void quantize(const tShape<T>& source)
+	{
+		if (vertices != nullptr)
+		{
+			delete[] vertices;
+			vertices = nullptr;
+		}
+		if (faceVerts != nullptr)
+		{
+			delete[] faceVerts;
+			faceVerts = nullptr;
+		}
+		count = source.count;
+		faceCount = source.faceCount;
+		tvec3<T> maximum(-std::numeric_limits<T>::max());
+		origin = tvec3<T>(std::numeric_limits<T>::max());
+		for (int i = 0; i < count; ++i)
+		{
+			const tvec3<T>& v = source.vertices[i];
+			origin = tvec3<T>(std::fmin(origin.x, v.x), std::fmin(origin.y, v.y), std::fmin(origin.z, v.z));
+			maximum = tvec3<T>(std::fmax(maximum.x, v.x), std::fmax(maximum.y, v.y), std::fmax(maximum.z, v.z));
+		}
+		const T steps = T(65535);
+		scale = (maximum - origin) * (T(1) / steps);
+		tvec3<T> inverseScale(scale.x > T(0) ? T(1) / scale.x : T(0),
+			scale.y > T(0) ? T(1) / scale.y : T(0),
+			scale.z > T(0) ? T(1) / scale.z : T(0));
+		if (count > 0)vertices = new QuantizedVertex[count];
+		for (int i = 0; i < count; ++i)
+		{
+			tvec3<T> local = source.vertices[i] - origin;
+			vertices[i].x = static_cast<uint16_t>(std::fmin(std::round(local.x * inverseScale.x), steps));
+			vertices[i].y = static_cast<uint16_t>(std::fmin(std::round(local.y * inverseScale.y), steps));
+			vertices[i].z = static_cast<uint16_t>(std::fmin(std::round(local.z * inverseScale.z), steps));
+		}
+		if (faceCount > 0)
+		{
+			faceVerts = new Indices3[faceCount];
+			for (int i = 0; i < faceCount; ++i)
+			{
+				faceVerts[i] = source.faceVerts[i];
+			}
+		}
+		//Half a quantization step per axis, plus the rounding of origin + scale * q
+		T extent = std::fmax(dot(origin, origin), dot(maximum, maximum));
+		bound = T(0.5) * std::sqrt(dot(scale, scale)) + T(4) * std::numeric_limits<T>::epsilon() * std::sqrt(extent);
+		//The source's volumes grown by the quantization error still enclose every dequantized vertex
+		bounds = source.getBounds();
+		bounds.minimum = bounds.minimum - tvec3<T>(bound);
+		bounds.maximum = bounds.maximum + tvec3<T>(bound);
+		bounds.radius += bound;
+	}
+	tvec3<T> supportVertex(const tvec3<T>& direction, uint32_t& id) const
+	{
+		id = supportPointFrom(direction, id);
+		return getVertex(id);
+	}
+	tvec3<T> getVertex(const uint32_t& index) const
+	{
+		const QuantizedVertex& q = vertices[index];
+		return origin + tvec3<T>(scale.x * q.x, scale.y * q.y, scale.z * q.z);
+	}
+	tvec3<T> getVertex(const uint32_t& index, const tmat3<T>& orientation, const tvec3<T>& position) const
+	{
+		return (orientation * getVertex(index)) + position;
+	}
+	uint32_t supportPoint(const tvec3<T>& direction) const
+	{
+		//Direction scaled into the quantized grid, the origin term is the same for every vertex
+		tvec3<T> d(direction.x * scale.x, direction.y * scale.y, direction.z * scale.z);
+		T magnitude = -std::numeric_limits<T>::max();
+		uint32_t tempID = 0;
+		for (int i = 0; i < count; ++i)
+		{
+			T dR = d.x * vertices[i].x + d.y * vertices[i].y + d.z * vertices[i].z;
+			if (dR > magnitude)
+			{
+				magnitude = dR;
+				tempID = i;
+			}
+		}
+		return tempID;
+	}
+	uint32_t supportPoint(const tvec3<T>& direction, const tmat3<T>& orientation) const
+	{
+		return supportPoint(transposeMultiply(orientation, direction));
+	}
+	//The quantized mesh keeps no adjacency to climb, so it always scans and the seed goes unused
+	uint32_t supportPointFrom(const tvec3<T>& direction, const uint32_t& /*seed*/) const
+	{
+		return supportPoint(direction);
+	}
+	uint32_t supportPointFrom(const tvec3<T>& direction, const tmat3<T>& orientation, const uint32_t& /*seed*/) const
+	{
+		return supportPoint(direction, orientation);
+	}
+	const tBounds<T>& getBounds() const
+	{
+		return bounds;
+	}
+	T errorBound() const
+	{//maximum distance between a dequantized vertex and its source
+		return bound;
+	}
+	int count = 0;
+	int faceCount = 0;
+	tvec3<T> origin;
+	tvec3<T> scale;
+	T bound = 0.0f;
+	tBounds<T> bounds;
+	QuantizedVertex* vertices = nullptr;
+	Indices3* faceVerts = nullptr;
+};
+
+typedef tQuantizedShape<float> QuantizedShape;
+
+#endif
@@ -4,14 +4,36 @@ Date Modified: 8/5/2021
 
 Purpose: Simple mesh class for shapes.
 	Note, this is not a class that would be ideal to reuse with modifications.
-	This uses manual memory allocation and limits the size of the
-		mesh to the most complex mesh being tested in this program!
+	All of a shape's arrays are sized to its mesh and share one contiguous
+		block, taken from an Arena when one is given or from the heap.
+		Arena blocks are released with the arena, never by the shape.
+	Vertex adjacency is stored as compressed sparse rows, one offset per
+		vertex into a single packed neighbor array.
+	Support queries on large convex meshes can hill climb over the adjacency
+		from a previous support point instead of scanning every vertex.
+		An optional cube map of quantized directions supplies a starting
+		vertex on or next to the answer when the previous one is far off.
+	A local box and bounding sphere are cached for early out tests.
+	Deforming meshes move vertices through moveVertex, which only marks them,
+		and updateFaces then recomputes the normals and edges of the faces
+		around marked vertices, so the cost follows how much of the mesh moved.
+		Large updates are split over a ThreadPool through dispatchJob, so they
+		carry its restrictions.
+	reorderForLocality renumbers a loaded mesh so vertices near each other in
+		space, and faces sharing vertices, sit near each other in memory.
 */
 
 #ifndef __SHAPE__
 #define __SHAPE__
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <new>
+#include <utility>
+#include "Arena.hpp"
+#include "ThreadPool.hpp"
 #include "VectorMath.hpp"
 
 struct Indices3
@@ -19,233 +41,872 @@ struct Indices3
 	int ind[3];
 };
 
-struct TriEdges
+//Support id reported by shapes without discrete vertices, GJK never treats it as a repeat
+const uint32_t noFeatureID = 0xFFFFFFFFu;
+
+//Local axis aligned box and bounding sphere, for rejecting separated pairs before any exact test
+template <typename T>
+struct tBounds
 {
-	vec3 edge[2];
+	tvec3<T> minimum;
+	tvec3<T> maximum;
+	tvec3<T> center;
+	T radius = T(0);
 };
 
-class Shape
+//Box of the points, and the sphere about the box center reaching the furthest point
+template <typename T>
+tBounds<T> computeBounds(const tvec3<T>* points, int N)
+{
+	tBounds<T> bounds;
+	if (N < 1)return bounds;
+	bounds.minimum = points[0];
+	bounds.maximum = points[0];
+	for (int i = 1; i < N; ++i)
+	{
+		const tvec3<T>& p = points[i];
+		bounds.minimum = tvec3<T>(std::fmin(bounds.minimum.x, p.x), std::fmin(bounds.minimum.y, p.y), std::fmin(bounds.minimum.z, p.z));
+		bounds.maximum = tvec3<T>(std::fmax(bounds.maximum.x, p.x), std::fmax(bounds.maximum.y, p.y), std::fmax(bounds.maximum.z, p.z));
+	}
+	bounds.center = (bounds.minimum + bounds.maximum) * T(0.5);
+	T radiusSq = T(0);
+	for (int i = 0; i < N; ++i)
+	{
+		tvec3<T> offset = points[i] - bounds.center;
+		radiusSq = std::fmax(radiusSq, dot(offset, offset));
+	}
+	bounds.radius = std::sqrt(radiusSq);
+	return bounds;
+}
+
+//Squared distance from point to the segment start + t * motion, t in [0, 1]
+template <typename T>
+T segmentPointDistanceSq(const tvec3<T>& start, const tvec3<T>& motion, const tvec3<T>& point)
+{
+	tvec3<T> offset = point - start;
+	T lengthSq = dot(motion, motion);
+	T t = (lengthSq > T(0)) ? dot(offset, motion) / lengthSq : T(0);
+	t = (t < T(0)) ? T(0) : ((t > T(1)) ? T(1) : t);
+	tvec3<T> gap = offset - motion * t;
+	return dot(gap, gap);
+}
+
+//Slab test of the segment start + t * motion, t in [0, 1], against a box
+template <typename T>
+bool segmentHitsBox(const tvec3<T>& start, const tvec3<T>& motion, const tvec3<T>& minimum, const tvec3<T>& maximum)
+{
+	const T s[3] = { start.x, start.y, start.z };
+	const T m[3] = { motion.x, motion.y, motion.z };
+	const T low[3] = { minimum.x, minimum.y, minimum.z };
+	const T high[3] = { maximum.x, maximum.y, maximum.z };
+	T enter = T(0), exit = T(1);
+	for (int i = 0; i < 3; ++i)
+	{
+		if (m[i] == T(0))
+		{
+			if (s[i] < low[i] || s[i] > high[i])return false;
+			continue;
+		}
+		T inverse = T(1) / m[i];
+		T t0 = (low[i] - s[i]) * inverse, t1 = (high[i] - s[i]) * inverse;
+		if (t0 > t1)std::swap(t0, t1);
+		enter = (t0 > enter) ? t0 : enter;
+		exit = (t1 < exit) ? t1 : exit;
+		if (enter > exit)return false;
+	}
+	return true;
+}
+
+template <typename T>
+struct tTriEdges
+{
+	tvec3<T> edge[2];
+};
+
+typedef tTriEdges<float> TriEdges;
+
+template <typename T>
+class tShape;
+
+//Faces of one updateFaces call, split into blocks for the ThreadPool
+template <typename T>
+struct tFaceUpdate
+{
+	tShape<T>* shape = nullptr;
+	const int* faces = nullptr;
+	int faceCount = 0;
+	static const int blockSize = 256;
+	void run(unsigned int block) const;
+	unsigned int blockCount() const
+	{
+		return static_cast<unsigned int>((faceCount + blockSize - 1) / blockSize);
+	}
+};
+
+//Fewer changed faces than this are not worth a dispatch
+const int faceUpdateParallelThreshold = 4096;
+
+template <typename T>
+class tShape
 {
 public:
-	Shape()
+	//Widest row accepted by the neighbor table constructor
+	static const int maxValence = 16;
+	tShape()
 	{
-		vertices[0] = vec3(12.0f, 0.0f, 0.0f);
-		if (edges == nullptr)
+		//NULL
+	}
+	tShape(tvec3<T>* positions, int N, Arena* arena = nullptr)
+	{
+		allocate(N, 2 * (N - 2), 0, arena);
+		for (int i = 0; i < N; ++i)
 		{
-			edges = new int* [242];
-			for (unsigned int i = 0; i < 242; ++i)
-			{
-				edges[i] = new int[16];
-			}
+			vertices[i] = positions[i];
 		}
-		if (edgeAlt == nullptr)edgeAlt = new int[242 * 16];
-		if (edgeCount == nullptr)edgeCount = new int[242];
+		bounds = computeBounds(vertices, count);
 	}
-	Shape(vec3* positions, int N)
+	//neighbors[i] lists the valence[i] vertices adjacent to vertex i, packed into compressed sparse rows
+	tShape(tvec3<T>* positions, int N, const int* valence, const int (*neighbors)[maxValence], Arena* arena = nullptr)
 	{
-		//vertices = new vec3[N];
-		count = N;
+		int total = 0;
+		for (int i = 0; i < N; ++i)
+		{
+			total += valence[i];
+		}
+		allocate(N, 2 * (N - 2), total, arena);
+		adjacencyCount = total;
 		for (int i = 0; i < N; ++i)
 		{
 			vertices[i] = positions[i];
+			adjacencyOffsets[i + 1] = adjacencyOffsets[i] + valence[i];
+			for (int j = 0; j < valence[i]; ++j)
+			{
+				adjacency[adjacencyOffsets[i] + j] = neighbors[i][j];
+			}
+		}
+		bounds = computeBounds(vertices, count);
+	}
+	~tShape()
+	{
+		if (ownsStorage && storage != nullptr)
+		{
+			delete[] storage;
+		}
+		releaseSupportCache();
+		releaseDeformation();
+	}
+	//Copies land in their own heap block, whichever arena the source used
+	tShape(const tShape& cp)
+	{
+		copyFrom(cp);
+	}
+	tShape& operator=(const tShape& cp)
+	{
+		if (this != &cp)
+		{
+			tShape temp(cp);
+			swap(temp);
+		}
+		return *this;
+	}
+	tShape(tShape&& mv) noexcept
+	{
+		swap(mv);
+	}
+	tShape& operator=(tShape&& mv) noexcept
+	{
+		swap(mv);
+		return *this;
+	}
+	//Precision conversion
+	template <typename U>
+	explicit tShape(const tShape<U>& cp)
+	{
+		copyFrom(cp);
+	}
+	size_t storageBytes() const
+	{
+		return storageSize;
+	}
+	tvec3<T> getVertex(const uint32_t& index) const
+	{
+		return vertices[index];
+	}
+	/*
+	__device__ tvec3<T>* getVertices()
+	{
+		return vertices;
+	}
+	*/
+	uint32_t supportPoint(const tvec3<T>& direction) const
+	{
+		T magnitude = -999999;
+		uint32_t tempID = 0;
+		for (int i = 0; i < count; ++i)
+		{
+			T dR = dot(vertices[i], direction);
+			if (dR > magnitude)
+			{
+				magnitude = dR;// dot(vertices[i], direction);
+				tempID = i;
+			}
 		}
-		if (edges == nullptr)
+		return tempID;
+	}
+	uint32_t supportPoint(const tvec3<T>& direction, const tvec3<T>& t) const
+	{
+		T magnitude = -999999;
+		uint32_t tempID = 0;
+		for (int i = 0; i < count; ++i)
 		{
-			edges = new int* [242];
-			for (unsigned int i = 0; i < 242; ++i)
+			T dR = dot((vertices[i] + t), direction);
+			if (dR > magnitude)
 			{
-				edges[i] = new int[16];
+				magnitude = dR;
+				tempID = i;
 			}
 		}
-		if (edgeAlt == nullptr)edgeAlt = new int[242 * 16];
-		if (edgeCount == nullptr)edgeCount = new int[242];
-		faceCount = 2 * (N - 2);
-		if (faces == nullptr)faces = new vec3[faceCount];
-		if (faceVerts == nullptr)faceVerts = new Indices3[faceCount];
-		if (faceEdges == nullptr)faceEdges = new TriEdges[faceCount];
+		return tempID;
 	}
-	~Shape()
+	uint32_t supportPoint(const tvec3<T>& direction, const tmat3<T>& orientation) const
 	{
-		//if (vertices != NULL)delete[] vertices;
-		if (edges != nullptr)
+		//Rotate the search direction into the local frame instead of rotating every vertex
+		return supportPoint(transposeMultiply(orientation, direction));
+	}
+	tvec3<T> getVertex(const uint32_t& index, const tmat3<T>& orientation, const tvec3<T>& position) const
+	{
+		return (orientation * vertices[index]) + position;
+	}
+	//Walks to the neighbor furthest along direction until no neighbor improves, exact on convex meshes
+	uint32_t supportPointHillClimb(const tvec3<T>& direction, const uint32_t& prevID) const
+	{
+		uint32_t curID = prevID;
+		T magnitude = dot(vertices[curID], direction);
+		bool end = false;
+		while (!end)
 		{
-			for (unsigned int i = 0; i < 242; ++i)
+			uint32_t tempID = curID;
+			T nMag = magnitude;
+			for (int i = adjacencyOffsets[curID]; i < adjacencyOffsets[curID + 1]; ++i)
 			{
-				delete[] edges[i];
+				T dR = dot(vertices[adjacency[i]], direction);
+				if (dR > nMag)
+				{
+					nMag = dR;
+					tempID = adjacency[i];
+				}
+			}
+			if (tempID != curID)
+			{
+				curID = tempID;
+				magnitude = nMag;
 			}
-			delete[] edges;
+			else end = true;
 		}
-		if (edgeAlt != nullptr)
+		return curID;
+	}
+	//Warm started support query, hill climbs from seed on large convex meshes and scans otherwise
+	//	With a support cache the climb starts from whichever of seed and the cached vertex is further along direction
+	uint32_t supportPointFrom(const tvec3<T>& direction, const uint32_t& seed) const
+	{
+		if (!convex || count <= hillClimbThreshold)return supportPoint(direction);
+		if (supportCache == nullptr)return supportPointHillClimb(direction, seed);
+		uint32_t cached = supportCache[cacheCell(direction)];
+		if (dot(vertices[cached], direction) > dot(vertices[seed], direction))return supportPointHillClimb(direction, cached);
+		return supportPointHillClimb(direction, seed);
+	}
+	uint32_t supportPointFrom(const tvec3<T>& direction, const tmat3<T>& orientation, const uint32_t& seed) const
+	{
+		return supportPointFrom(transposeMultiply(orientation, direction), seed);
+	}
+	//Rebuilds the adjacency from faceVerts and tests whether hill climbing is exact on this mesh
+	void buildAdjacency()
+	{
+		//Both directions of every face edge, duplicates are removed per row below
+		int* offsets = new int[count + 1];
+		int* rows = new int[6 * faceCount];
+		for (int i = 0; i <= count; ++i)
 		{
-			delete[] edgeAlt;
+			offsets[i] = 0;
 		}
-		if (edgeCount != nullptr)
+		for (int i = 0; i < faceCount; ++i)
 		{
-			delete[] edgeCount;
+			for (int j = 0; j < 3; ++j)
+			{
+				offsets[faceVerts[i].ind[j] + 1] += 2;
+			}
 		}
-		if (faces != nullptr)
+		for (int i = 0; i < count; ++i)
 		{
-			delete[] faces;
+			offsets[i + 1] += offsets[i];
 		}
-		if (faceVerts != nullptr)
+		int* fill = new int[count];
+		for (int i = 0; i < count; ++i)
 		{
-			delete[] faceVerts;
+			fill[i] = offsets[i];
 		}
-		if (faceEdges != nullptr)
+		for (int i = 0; i < faceCount; ++i)
 		{
-			delete[] faceEdges;
+			for (int j = 0; j < 3; ++j)
+			{
+				int a = faceVerts[i].ind[j], b = faceVerts[i].ind[(j + 1) % 3];
+				rows[fill[a]++] = b;
+				rows[fill[b]++] = a;
+			}
+		}
+		int total = 0;
+		bool fits = true;
+		for (int i = 0; i < count; ++i)
+		{
+			int rowStart = total;
+			for (int j = offsets[i]; j < offsets[i + 1]; ++j)
+			{
+				bool repeated = false;
+				for (int k = rowStart; k < total; ++k)
+				{
+					if (adjacency[k] == rows[j])repeated = true;
+				}
+				if (repeated)continue;
+				if (total == adjacencyCapacity)
+				{//not a closed mesh, rows are truncated and hill climbing stays off
+					fits = false;
+					continue;
+				}
+				adjacency[total++] = rows[j];
+			}
+			adjacencyOffsets[i + 1] = total;
 		}
+		delete[] fill;
+		delete[] rows;
+		delete[] offsets;
+		adjacencyCount = total;
+		convex = fits && locallyConvex();
 	}
-	//Host only on the copy constructor and copy assignment
-	Shape(const Shape& cp)
+	//Support point in the local frame, id carries the previous support index in and the new one out
+	tvec3<T> supportVertex(const tvec3<T>& direction, uint32_t& id) const
 	{
-		if (cp.vertices != NULL)
+		id = supportPointFrom(direction, id);
+		return vertices[id];
+	}
+	//Cube map of resolution * resolution cells per face, each holding the support point of its center direction
+	//	Only built for convex meshes, where any seed leads the hill climb to the true support point
+	void buildSupportCache(int resolution = 8)
+	{
+		releaseSupportCache();
+		if (!convex || resolution < 1)return;
+		cacheResolution = resolution;
+		supportCache = new uint32_t[6 * resolution * resolution];
+		for (int face = 0; face < 6; ++face)
 		{
-			this->count = cp.count;
-			//Below should not happen, just adding it
-			//if (this->vertices != NULL)delete[] this->vertices;
-			//this->vertices = new vec3[cp.count];
-			for (int i = 0; i < cp.count; ++i)
+			int axis = face >> 1;
+			T sign = (face & 1) ? T(-1) : T(1);
+			for (int v = 0; v < resolution; ++v)
 			{
-				this->vertices[i] = cp.vertices[i];
+				for (int u = 0; u < resolution; ++u)
+				{
+					T components[3];
+					components[axis] = sign;
+					components[(axis + 1) % 3] = (T(2) * (T(u) + T(0.5))) / T(resolution) - T(1);
+					components[(axis + 2) % 3] = (T(2) * (T(v) + T(0.5))) / T(resolution) - T(1);
+					supportCache[(face * resolution + v) * resolution + u] = supportPoint(tvec3<T>(components[0], components[1], components[2]));
+				}
 			}
 		}
-		if (edges == nullptr)
+	}
+	//Renumbers vertices along a Morton curve through the bounding box, then sorts faces by their lowest vertex
+	//	Hill climbing, adjacency rows and face loops then touch nearby memory, all index arrays are remapped to match
+	void reorderForLocality()
+	{
+		if (count < 2)return;
+		//Pending moves are applied first, the vertex to face table is rebuilt on the next update
+		updateFaces();
+		releaseDeformation();
+		std::pair<uint32_t, int>* keys = new std::pair<uint32_t, int>[count];
+		for (int i = 0; i < count; ++i)
 		{
-			edges = new int* [242];
-			for (unsigned int i = 0; i < 242; ++i)
+			keys[i] = std::make_pair(mortonCode(vertices[i]), i);
+		}
+		std::sort(keys, keys + count);
+		int* remap = new int[count];//old index to new
+		tvec3<T>* moved = new tvec3<T>[count];
+		int* movedOffsets = new int[count + 1];
+		int* movedAdjacency = new int[adjacencyCount > 0 ? adjacencyCount : 1];
+		for (int i = 0; i < count; ++i)
+		{
+			remap[keys[i].second] = i;
+		}
+		movedOffsets[0] = 0;
+		for (int i = 0; i < count; ++i)
+		{
+			int old = keys[i].second;
+			moved[i] = vertices[old];
+			movedOffsets[i + 1] = movedOffsets[i];
+			for (int j = adjacencyOffsets[old]; j < adjacencyOffsets[old + 1]; ++j)
 			{
-				edges[i] = new int[16];
+				movedAdjacency[movedOffsets[i + 1]++] = remap[adjacency[j]];
 			}
 		}
-		if (edgeAlt == nullptr)edgeAlt = new int[242 * 16];
-		if (edgeCount == nullptr)edgeCount = new int[242];
-		faceCount = cp.faceCount;
+		for (int i = 0; i < count; ++i)
+		{
+			vertices[i] = moved[i];
+			adjacencyOffsets[i + 1] = movedOffsets[i + 1];
+		}
+		for (int i = 0; i < adjacencyCount; ++i)
+		{
+			adjacency[i] = movedAdjacency[i];
+		}
+		if (supportCache != nullptr)
+		{
+			for (int i = 0; i < 6 * cacheResolution * cacheResolution; ++i)
+			{
+				supportCache[i] = remap[supportCache[i]];
+			}
+		}
+		//Corner order within a face is kept, so faceEdges stay valid
 		if (faceCount > 0)
 		{
-			faces = new vec3[faceCount];
-			faceVerts = new Indices3[faceCount];
-			faceEdges = new TriEdges[faceCount];
+			std::pair<int, int>* faceKeys = new std::pair<int, int>[faceCount];
+			for (int i = 0; i < faceCount; ++i)
+			{
+				for (int k = 0; k < 3; ++k)
+				{
+					faceVerts[i].ind[k] = remap[faceVerts[i].ind[k]];
+				}
+				faceKeys[i] = std::make_pair(std::min(faceVerts[i].ind[0], std::min(faceVerts[i].ind[1], faceVerts[i].ind[2])), i);
+			}
+			std::sort(faceKeys, faceKeys + faceCount);
+			tvec3<T>* movedFaces = new tvec3<T>[faceCount];
+			Indices3* movedFaceVerts = new Indices3[faceCount];
+			tTriEdges<T>* movedFaceEdges = new tTriEdges<T>[faceCount];
+			for (int i = 0; i < faceCount; ++i)
+			{
+				movedFaces[i] = faces[faceKeys[i].second];
+				movedFaceVerts[i] = faceVerts[faceKeys[i].second];
+				movedFaceEdges[i] = faceEdges[faceKeys[i].second];
+			}
+			for (int i = 0; i < faceCount; ++i)
+			{
+				faces[i] = movedFaces[i];
+				faceVerts[i] = movedFaceVerts[i];
+				faceEdges[i] = movedFaceEdges[i];
+			}
+			delete[] movedFaceEdges;
+			delete[] movedFaceVerts;
+			delete[] movedFaces;
+			delete[] faceKeys;
 		}
+		delete[] movedAdjacency;
+		delete[] movedOffsets;
+		delete[] moved;
+		delete[] remap;
+		delete[] keys;
+	}
+	//Moves one vertex and marks it, its faces keep their old normals and edges until updateFaces
+	void moveVertex(const int index, const tvec3<T>& position)
+	{
+		vertices[index] = position;
+		markVertex(index);
 	}
-	Shape& operator=(const Shape& cp)
+	//Recomputes normals and edges of the faces around vertices moved since the last call, returns how many faces changed
+	//	Bounds only grow to cover the moved vertices, call updateBounds to tighten them
+	//	Convexity and the support cache are not checked again, call buildAdjacency and buildSupportCache if the change may break them
+	int updateFaces(ThreadPool* pool = nullptr)
 	{
-		/*if (this->vertices == NULL)
+		if (deformation == nullptr || deformation->pendingCount == 0)return 0;
+		if (deformation->faceOffsets == nullptr)buildVertexFaces();
+		int changed = 0;
+		for (int i = 0; i < deformation->pendingCount; ++i)
 		{
-			this->count = cp.count;
-			this->vertices = new vec3[cp.count];
+			int vertex = deformation->pending[i];
+			deformation->moved[vertex] = 0;
+			growBounds(vertices[vertex]);
+			for (int j = deformation->faceOffsets[vertex]; j < deformation->faceOffsets[vertex + 1]; ++j)
+			{
+				int face = deformation->faceList[j];
+				if (deformation->faceQueued[face])continue;
+				deformation->faceQueued[face] = 1;
+				deformation->faceQueue[changed++] = face;
+			}
 		}
-		else if (this->count != cp.count)
-		{
-			this->count = cp.count;
-			delete[] this->vertices;
-			this->vertices = new vec3[cp.count];
-		}*/
-		this->count = cp.count;
-		for (int i = 0; i < cp.count; ++i)
+		deformation->pendingCount = 0;
+		tFaceUpdate<T> job;
+		job.shape = this;
+		job.faces = deformation->faceQueue;
+		job.faceCount = changed;
+		if (pool != nullptr && changed >= faceUpdateParallelThreshold)
 		{
-			this->vertices[i] = cp.vertices[i];
+			dispatchJob(*pool, job);
 		}
-		if (edges == nullptr)
+		else
 		{
-			edges = new int* [242];
-			for (unsigned int i = 0; i < 242; ++i)
+			for (unsigned int i = 0; i < job.blockCount(); ++i)
 			{
-				edges[i] = new int[16];
+				job.run(i);
 			}
 		}
-		if (edgeAlt == nullptr)edgeAlt = new int[242 * 16];
-		if (edgeCount == nullptr)edgeCount = new int[242];
-		faceCount = cp.faceCount;
-		if (faceCount > 0)
+		for (int i = 0; i < changed; ++i)
 		{
-			faces = new vec3[faceCount];
-			faceVerts = new Indices3[faceCount];
-			faceEdges = new TriEdges[faceCount];
+			deformation->faceQueued[deformation->faceQueue[i]] = 0;
 		}
-		return *this;
+		return changed;
 	}
-	vec3 getVertex(const uint32_t& index) const
+	//Normal and edges of one face from its current corners
+	void recomputeFace(const int index)
 	{
-		return vertices[index];
+		const Indices3& face = faceVerts[index];
+		tvec3<T> A = vertices[face.ind[1]] - vertices[face.ind[0]];
+		tvec3<T> B = vertices[face.ind[2]] - vertices[face.ind[0]];
+		tvec3<T> normal = cross(A, B);
+		T length = std::sqrt(dot(normal, normal));
+		faces[index] = (length > T(0)) ? normal * (T(1) / length) : normal;
+		faceEdges[index].edge[0] = A;
+		faceEdges[index].edge[1] = B;
 	}
-	/*
-	__device__ vec3* getVertices()
+	int pendingVertexCount() const
 	{
-		return vertices;
+		return (deformation == nullptr) ? 0 : deformation->pendingCount;
 	}
-	*/
-	uint32_t supportPoint(const vec3& direction) const
+	//False when the storage came from an arena and only dies with it
+	bool ownsMemory() const
 	{
-		float magnitude = -999999;
-		uint32_t tempID = 0;
-		for (int i = 0; i < count; ++i)
+		return ownsStorage;
+	}
+	//Computed from the vertices on construction, call updateBounds after moving vertices
+	const tBounds<T>& getBounds() const
+	{
+		return bounds;
+	}
+	void updateBounds()
+	{
+		bounds = computeBounds(vertices, count);
+	}
+	int valence(const int index) const
+	{
+		return adjacencyOffsets[index + 1] - adjacencyOffsets[index];
+	}
+	//Meshes with fewer vertices are cheaper to scan than to walk
+	static const int hillClimbThreshold = 32;
+	int count = 0;
+	int adjacencyCount = 0;
+	int faceCount = 0;
+	//Every array below points into one block, sized to this mesh
+	tvec3<T>* vertices = nullptr;
+	//Neighbors of vertex i are adjacency[adjacencyOffsets[i]] up to adjacency[adjacencyOffsets[i + 1]]
+	int* adjacencyOffsets = nullptr;
+	int* adjacency = nullptr;
+	tvec3<T>* faces = nullptr;
+	Indices3* faceVerts = nullptr;
+	tTriEdges<T>* faceEdges = nullptr;
+	//Set by buildAdjacency, hill climbing only finds the true support point on a convex mesh
+	bool convex = false;
+private:
+	tBounds<T> bounds;
+	template <typename U>
+	friend class tShape;
+	static size_t align(size_t offset, size_t alignment)
+	{
+		return (offset + (alignment - 1)) & ~(alignment - 1);
+	}
+	int cacheCell(const tvec3<T>& direction) const
+	{
+		T components[3] = { direction.x, direction.y, direction.z };
+		T magnitudes[3] = { std::fabs(direction.x), std::fabs(direction.y), std::fabs(direction.z) };
+		int axis = (magnitudes[0] >= magnitudes[1]) ? ((magnitudes[0] >= magnitudes[2]) ? 0 : 2) : ((magnitudes[1] >= magnitudes[2]) ? 1 : 2);
+		if (magnitudes[axis] == T(0))return 0;
+		int face = 2 * axis + ((components[axis] < T(0)) ? 1 : 0);
+		T scale = T(0.5) * T(cacheResolution) / magnitudes[axis];
+		int u = static_cast<int>((components[(axis + 1) % 3] + magnitudes[axis]) * scale);
+		int v = static_cast<int>((components[(axis + 2) % 3] + magnitudes[axis]) * scale);
+		u = (u < cacheResolution) ? u : cacheResolution - 1;
+		v = (v < cacheResolution) ? v : cacheResolution - 1;
+		return (face * cacheResolution + v) * cacheResolution + u;
+	}
+	//Interleaved bits of the position quantized to 10 bits per axis within the bounding box
+	uint32_t mortonCode(const tvec3<T>& p) const
+	{
+		tvec3<T> extent = bounds.maximum - bounds.minimum;
+		const T values[3] = { p.x - bounds.minimum.x, p.y - bounds.minimum.y, p.z - bounds.minimum.z };
+		const T extents[3] = { extent.x, extent.y, extent.z };
+		uint32_t code = 0;
+		for (int axis = 0; axis < 3; ++axis)
 		{
-			float dR = dot(vertices[i], direction);
-			if (dR > magnitude)
+			uint32_t cell = 0;
+			if (extents[axis] > T(0))
 			{
-				magnitude = dR;// dot(vertices[i], direction);
-				tempID = i;
+				T scaled = values[axis] / extents[axis] * T(1023);
+				cell = (scaled <= T(0)) ? 0u : ((scaled >= T(1023)) ? 1023u : static_cast<uint32_t>(scaled));
+			}
+			for (int bit = 0; bit < 10; ++bit)
+			{
+				code |= ((cell >> bit) & 1u) << (3 * bit + axis);
 			}
 		}
-		return tempID;
+		return code;
 	}
-	uint32_t supportPoint(const vec3& direction, const vec3& t) const
+	//Per vertex faces as compressed sparse rows, plus the marks of pending vertices and queued faces
+	struct Deformation
 	{
-		float magnitude = -999999;
-		uint32_t tempID = 0;
+		int* faceOffsets = nullptr;
+		int* faceList = nullptr;
+		char* moved = nullptr;
+		int* pending = nullptr;
+		int pendingCount = 0;
+		char* faceQueued = nullptr;
+		int* faceQueue = nullptr;
+		~Deformation()
+		{
+			delete[] faceOffsets;
+			delete[] faceList;
+			delete[] moved;
+			delete[] pending;
+			delete[] faceQueued;
+			delete[] faceQueue;
+		}
+	};
+	void markVertex(const int index)
+	{
+		if (deformation == nullptr)
+		{
+			deformation = new Deformation();
+			deformation->moved = new char[count];
+			deformation->pending = new int[count];
+			for (int i = 0; i < count; ++i)
+			{
+				deformation->moved[i] = 0;
+			}
+		}
+		if (deformation->moved[index])return;
+		deformation->moved[index] = 1;
+		deformation->pending[deformation->pendingCount++] = index;
+	}
+	void buildVertexFaces()
+	{
+		int* offsets = new int[count + 1];
+		int* list = new int[3 * faceCount];
+		for (int i = 0; i <= count; ++i)
+		{
+			offsets[i] = 0;
+		}
+		for (int i = 0; i < faceCount; ++i)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				++offsets[faceVerts[i].ind[k] + 1];
+			}
+		}
 		for (int i = 0; i < count; ++i)
 		{
-			float dR = dot((vertices[i] + t), direction);
-			if (dR > magnitude)
+			offsets[i + 1] += offsets[i];
+		}
+		int* fill = new int[count];
+		for (int i = 0; i < count; ++i)
+		{
+			fill[i] = offsets[i];
+		}
+		for (int i = 0; i < faceCount; ++i)
+		{
+			for (int k = 0; k < 3; ++k)
 			{
-				magnitude = dR;
-				tempID = i;
+				list[fill[faceVerts[i].ind[k]]++] = i;
 			}
 		}
-		return tempID;
+		delete[] fill;
+		deformation->faceOffsets = offsets;
+		deformation->faceList = list;
+		deformation->faceQueued = new char[faceCount];
+		deformation->faceQueue = new int[faceCount];
+		for (int i = 0; i < faceCount; ++i)
+		{
+			deformation->faceQueued[i] = 0;
+		}
 	}
-	uint32_t supportPointHillClimb(const vec3& direction, const int& prevID)
+	void growBounds(const tvec3<T>& p)
 	{
-		float magnitude = -999999;
-		float nMag = magnitude;
-		uint32_t tempID = 0;
-		uint32_t curID = prevID;
-		uint32_t lastID = prevID;
-		bool end = false;
-		while (!end)
+		bounds.minimum = tvec3<T>(std::fmin(bounds.minimum.x, p.x), std::fmin(bounds.minimum.y, p.y), std::fmin(bounds.minimum.z, p.z));
+		bounds.maximum = tvec3<T>(std::fmax(bounds.maximum.x, p.x), std::fmax(bounds.maximum.y, p.y), std::fmax(bounds.maximum.z, p.z));
+		tvec3<T> offset = p - bounds.center;
+		bounds.radius = std::fmax(bounds.radius, std::sqrt(dot(offset, offset)));
+	}
+	void releaseDeformation()
+	{
+		if (deformation != nullptr)
+		{
+			delete deformation;
+			deformation = nullptr;
+		}
+	}
+	void releaseSupportCache()
+	{
+		if (supportCache != nullptr)
 		{
-			for (int i = 0; i < edgeCount[curID]; ++i)
+			delete[] supportCache;
+			supportCache = nullptr;
+		}
+		cacheResolution = 0;
+	}
+	//Every vertex's one ring lies on one side of each face plane, for a closed mesh this makes it convex
+	bool locallyConvex() const
+	{
+		for (int i = 0; i < faceCount; ++i)
+		{
+			const tvec3<T>& origin = vertices[faceVerts[i].ind[0]];
+			tvec3<T> normal = cross(vertices[faceVerts[i].ind[1]] - origin, vertices[faceVerts[i].ind[2]] - origin);
+			T normalLength = std::sqrt(dot(normal, normal));
+			bool front = false, back = false;
+			for (int j = 0; j < 3; ++j)
 			{
-				float dR = dot(vertices[edges[curID][i]], direction);
-				if (dR > nMag)
+				int corner = faceVerts[i].ind[j];
+				for (int k = adjacencyOffsets[corner]; k < adjacencyOffsets[corner + 1]; ++k)
 				{
-					nMag = dR;
-					tempID = edges[curID][i];
+					tvec3<T> offset = vertices[adjacency[k]] - origin;
+					T side = dot(offset, normal);
+					T tolerance = T(0.0001) * normalLength * std::sqrt(dot(offset, offset));
+					if (side > tolerance)front = true;
+					else if (side < -tolerance)back = true;
 				}
 			}
-			if (nMag > magnitude)
+			if (front && back)return false;
+		}
+		return true;
+	}
+	void allocate(int N, int faceN, int adjacencyN, Arena* arena)
+	{
+		//Room for the adjacency of a closed triangle mesh, 3 directed edges per face, so buildAdjacency fits in place
+		if (adjacencyN < 3 * faceN)adjacencyN = 3 * faceN;
+		//Laid out largest alignment first: vectors, then integer data
+		size_t verticesOffset = 0;
+		size_t facesOffset = align(verticesOffset + sizeof(tvec3<T>) * N, alignof(tvec3<T>));
+		size_t faceEdgesOffset = align(facesOffset + sizeof(tvec3<T>) * faceN, alignof(tTriEdges<T>));
+		size_t offsetsOffset = align(faceEdgesOffset + sizeof(tTriEdges<T>) * faceN, alignof(int));
+		size_t adjacencyOffset = align(offsetsOffset + sizeof(int) * (N + 1), alignof(int));
+		size_t faceVertsOffset = align(adjacencyOffset + sizeof(int) * adjacencyN, alignof(Indices3));
+		storageSize = faceVertsOffset + sizeof(Indices3) * faceN;
+		if (arena != nullptr)
+		{
+			storage = static_cast<char*>(arena->allocate(storageSize, alignof(std::max_align_t)));
+			ownsStorage = false;
+		}
+		else
+		{
+			storage = new char[storageSize];
+			ownsStorage = true;
+		}
+		count = N;
+		faceCount = faceN;
+		adjacencyCount = 0;
+		adjacencyCapacity = adjacencyN;
+		vertices = reinterpret_cast<tvec3<T>*>(storage + verticesOffset);
+		faces = reinterpret_cast<tvec3<T>*>(storage + facesOffset);
+		faceEdges = reinterpret_cast<tTriEdges<T>*>(storage + faceEdgesOffset);
+		adjacencyOffsets = reinterpret_cast<int*>(storage + offsetsOffset);
+		adjacency = reinterpret_cast<int*>(storage + adjacencyOffset);
+		faceVerts = reinterpret_cast<Indices3*>(storage + faceVertsOffset);
+		for (int i = 0; i < N; ++i)
+		{
+			new (&vertices[i]) tvec3<T>();
+		}
+		for (int i = 0; i <= N; ++i)
+		{
+			adjacencyOffsets[i] = 0;
+		}
+		for (int i = 0; i < faceN; ++i)
+		{
+			new (&faces[i]) tvec3<T>();
+			new (&faceEdges[i]) tTriEdges<T>();
+		}
+	}
+	template <typename U>
+	void copyFrom(const tShape<U>& cp)
+	{
+		if (cp.storage == nullptr)return;
+		allocate(cp.count, cp.faceCount, cp.adjacencyCount, nullptr);
+		adjacencyCount = cp.adjacencyCount;
+		convex = cp.convex;
+		bounds.minimum = tvec3<T>(cp.bounds.minimum);
+		bounds.maximum = tvec3<T>(cp.bounds.maximum);
+		bounds.center = tvec3<T>(cp.bounds.center);
+		bounds.radius = static_cast<T>(cp.bounds.radius);
+		for (int i = 0; i < count; ++i)
+		{
+			vertices[i] = tvec3<T>(cp.vertices[i]);
+		}
+		for (int i = 0; i <= count; ++i)
+		{
+			adjacencyOffsets[i] = cp.adjacencyOffsets[i];
+		}
+		for (int i = 0; i < adjacencyCount; ++i)
+		{
+			adjacency[i] = cp.adjacency[i];
+		}
+		for (int i = 0; i < faceCount; ++i)
+		{
+			faces[i] = tvec3<T>(cp.faces[i]);
+			faceVerts[i] = cp.faceVerts[i];
+			faceEdges[i].edge[0] = tvec3<T>(cp.faceEdges[i].edge[0]);
+			faceEdges[i].edge[1] = tvec3<T>(cp.faceEdges[i].edge[1]);
+		}
+		if (cp.deformation != nullptr)
+		{
+			for (int i = 0; i < cp.deformation->pendingCount; ++i)
+			{
+				markVertex(cp.deformation->pending[i]);
+			}
+		}
+		if (cp.supportCache != nullptr)
+		{
+			cacheResolution = cp.cacheResolution;
+			supportCache = new uint32_t[6 * cacheResolution * cacheResolution];
+			for (int i = 0; i < 6 * cacheResolution * cacheResolution; ++i)
 			{
-				lastID = curID;
-				curID = tempID;
-				magnitude = nMag;
+				supportCache[i] = cp.supportCache[i];
 			}
-			else end = true;
 		}
-		return tempID;
 	}
-	vec3 vertices[242];
-	int count = 0;
-	int edgeTotal = 496;
-	int faceCount = 0;
-	//int edges[242][4];
-	//int edgeCount[242];
-	int** edges = nullptr;
-	int* edgeAlt = nullptr;
-	int* edgeCount = nullptr;
-	vec3* faces = nullptr;
-	Indices3* faceVerts = nullptr;
-	TriEdges* faceEdges = nullptr;
+	void swap(tShape& other)
+	{
+		std::swap(count, other.count);
+		std::swap(adjacencyCount, other.adjacencyCount);
+		std::swap(adjacencyCapacity, other.adjacencyCapacity);
+		std::swap(convex, other.convex);
+		std::swap(bounds, other.bounds);
+		std::swap(faceCount, other.faceCount);
+		std::swap(vertices, other.vertices);
+		std::swap(adjacencyOffsets, other.adjacencyOffsets);
+		std::swap(adjacency, other.adjacency);
+		std::swap(faces, other.faces);
+		std::swap(faceVerts, other.faceVerts);
+		std::swap(faceEdges, other.faceEdges);
+		std::swap(storage, other.storage);
+		std::swap(storageSize, other.storageSize);
+		std::swap(ownsStorage, other.ownsStorage);
+		std::swap(supportCache, other.supportCache);
+		std::swap(deformation, other.deformation);
+		std::swap(cacheResolution, other.cacheResolution);
+	}
+	int adjacencyCapacity = 0;
+	char* storage = nullptr;
+	size_t storageSize = 0;
+	bool ownsStorage = false;
+	//Optional, kept outside the mesh block since it is built after loading
+	uint32_t* supportCache = nullptr;
+	int cacheResolution = 0;
+	//Created by the first moveVertex
+	Deformation* deformation = nullptr;
 };
 
+template <typename T>
+void tFaceUpdate<T>::run(unsigned int block) const
+{
+	int end = (static_cast<int>(block) + 1) * blockSize;
+	if (end > faceCount)end = faceCount;
+	for (int i = static_cast<int>(block) * blockSize; i < end; ++i)
+	{
+		shape->recomputeFace(faces[i]);
+	}
+}
+
+typedef tShape<float> Shape;
+typedef tShape<double> dShape;
+typedef tBounds<float> Bounds;
+
 #endif
\ No newline at end of file
@@ -0,0 +1,298 @@
+/*
+Purpose: Dobkin-Kirkpatrick hierarchy for support queries on large convex meshes.
+	Level 0 is the mesh itself, every level above it removes an independent
+		set of low valence vertices and patches each hole with the faces of
+		the removed vertex's neighbors that it could see.
+		Each level keeps a constant fraction of the one below, so there are
+		O(log n) levels and the top one is small enough to scan.
+	A query scans the top level, then steps down one level at a time and hill
+		climbs from the vertex found above.
+		Only vertices of valence 10 or less are removed, high valence poles stay
+		in every level and a climb next to one checks all of its neighbors.
+	Patched holes may also connect coplanar neighbors through both diagonals,
+		levels only ever gain edges, which keeps every climb exact.
+	Built from a tShape whose adjacency came from buildAdjacency, and usable in
+		place of it in gjkDistance and gjkToI.
+	Non-convex shapes get no levels and fall back to the shape's linear scan.
+*/
+
+#ifndef __SUPPORT_HIERARCHY__
+#define __SUPPORT_HIERARCHY__
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "VectorMath.hpp"
+#include "Shape.hpp"
+
+template <typename T>
+class tSupportHierarchy
+{
+public:
+	tSupportHierarchy()
+	{
+		//NULL
+	}
+	explicit tSupportHierarchy(const tShape<T>& source)
+	{
+		build(source);
+	}
+	~tSupportHierarchy()
+	{
+		release();
+	}
+	tSupportHierarchy(const tSupportHierarchy&) = delete;
+	tSupportHierarchy& operator=(const tSupportHierarchy&) = delete;
+	//The shape must outlive the hierarchy
+	void build(const tShape<T>& source)
+	{
+		release();
+		shape = &source;
+		if (!source.convex || source.count < 4)return;
+		//Working copy of the current level, neighbors hold local indices
+		std::vector<int> ids(source.count);
+		std::vector<std::vector<int>> neighbors(source.count);
+		for (int i = 0; i < source.count; ++i)
+		{
+			ids[i] = i;
+			for (int j = source.adjacencyOffsets[i]; j < source.adjacencyOffsets[i + 1]; ++j)
+			{
+				neighbors[i].push_back(source.adjacency[j]);
+			}
+		}
+		std::vector<Level> built;
+		std::vector<int> down;
+		while (true)
+		{
+			built.push_back(store(ids, neighbors, down));
+			int N = static_cast<int>(ids.size());
+			if (N <= topCount)break;
+			//Greedy independent set of low valence vertices
+			std::vector<char> removed(N, 0), blocked(N, 0);
+			int removedCount = 0;
+			for (int i = 0; i < N; ++i)
+			{
+				if (blocked[i] || static_cast<int>(neighbors[i].size()) > maximumValence)continue;
+				if (N - removedCount <= topCount)break;
+				removed[i] = 1;
+				++removedCount;
+				blocked[i] = 1;
+				for (int n : neighbors[i])
+				{
+					blocked[n] = 1;
+				}
+			}
+			if (removedCount == 0)break;
+			//Neighbors of each removed vertex are joined along the hull faces that patch its hole
+			for (int i = 0; i < N; ++i)
+			{
+				if (removed[i])patchHole(ids, neighbors, i);
+			}
+			std::vector<int> remap(N, -1);
+			std::vector<int> nextIds;
+			down.clear();
+			for (int i = 0; i < N; ++i)
+			{
+				if (removed[i])continue;
+				remap[i] = static_cast<int>(nextIds.size());
+				nextIds.push_back(ids[i]);
+				down.push_back(i);
+			}
+			std::vector<std::vector<int>> nextNeighbors(nextIds.size());
+			for (int i = 0; i < N; ++i)
+			{
+				if (removed[i])continue;
+				for (int n : neighbors[i])
+				{
+					if (!removed[n])nextNeighbors[remap[i]].push_back(remap[n]);
+				}
+			}
+			ids.swap(nextIds);
+			neighbors.swap(nextNeighbors);
+		}
+		levelCount = static_cast<int>(built.size());
+		levels = new Level[levelCount];
+		for (int i = 0; i < levelCount; ++i)
+		{
+			levels[i] = built[i];
+		}
+	}
+	uint32_t supportPoint(const tvec3<T>& direction) const
+	{
+		if (levelCount == 0)return shape->supportPoint(direction);
+		const Level& top = levels[levelCount - 1];
+		T magnitude = dot(shape->vertices[top.vertexIds[0]], direction);
+		int current = 0;
+		for (int i = 1; i < top.count; ++i)
+		{
+			T dR = dot(shape->vertices[top.vertexIds[i]], direction);
+			if (dR > magnitude)
+			{
+				magnitude = dR;
+				current = i;
+			}
+		}
+		for (int l = levelCount - 1; l > 0; --l)
+		{
+			current = levels[l].down[current];
+			const Level& level = levels[l - 1];
+			bool end = false;
+			while (!end)
+			{
+				int next = current;
+				for (int i = level.offsets[current]; i < level.offsets[current + 1]; ++i)
+				{
+					T dR = dot(shape->vertices[level.vertexIds[level.adjacency[i]]], direction);
+					if (dR > magnitude)
+					{
+						magnitude = dR;
+						next = level.adjacency[i];
+					}
+				}
+				if (next != current)current = next;
+				else end = true;
+			}
+		}
+		return levels[0].vertexIds[current];
+	}
+	uint32_t supportPoint(const tvec3<T>& direction, const tmat3<T>& orientation) const
+	{
+		return supportPoint(transposeMultiply(orientation, direction));
+	}
+	//The descent does not need a seed
+	uint32_t supportPointFrom(const tvec3<T>& direction, const uint32_t& /*seed*/) const
+	{
+		return supportPoint(direction);
+	}
+	uint32_t supportPointFrom(const tvec3<T>& direction, const tmat3<T>& orientation, const uint32_t& /*seed*/) const
+	{
+		return supportPoint(direction, orientation);
+	}
+	tvec3<T> supportVertex(const tvec3<T>& direction, uint32_t& id) const
+	{
+		id = supportPointFrom(direction, id);
+		return shape->vertices[id];
+	}
+	tvec3<T> getVertex(const uint32_t& index) const
+	{
+		return shape->getVertex(index);
+	}
+	tvec3<T> getVertex(const uint32_t& index, const tmat3<T>& orientation, const tvec3<T>& position) const
+	{
+		return shape->getVertex(index, orientation, position);
+	}
+	const tBounds<T>& getBounds() const
+	{
+		return shape->getBounds();
+	}
+	int getLevelCount() const
+	{
+		return levelCount;
+	}
+	int getLevelSize(const int level) const
+	{
+		return levels[level].count;
+	}
+	//Vertices of a valence above this are never removed
+	static const int maximumValence = 10;
+	//Levels stop once this few vertices remain
+	static const int topCount = 16;
+private:
+	struct Level
+	{
+		int count;
+		int* vertexIds;//index into the shape's vertices
+		int* offsets;//count + 1 entries into adjacency
+		int* adjacency;//local indices
+		int* down;//local index of each vertex in the level below, empty on level 0
+	};
+	Level store(const std::vector<int>& ids, const std::vector<std::vector<int>>& neighbors, const std::vector<int>& down) const
+	{
+		Level level;
+		level.count = static_cast<int>(ids.size());
+		level.vertexIds = new int[level.count];
+		level.offsets = new int[level.count + 1];
+		level.down = down.empty() ? nullptr : new int[level.count];
+		level.offsets[0] = 0;
+		for (int i = 0; i < level.count; ++i)
+		{
+			level.vertexIds[i] = ids[i];
+			level.offsets[i + 1] = level.offsets[i] + static_cast<int>(neighbors[i].size());
+			if (level.down != nullptr)level.down[i] = down[i];
+		}
+		level.adjacency = new int[level.offsets[level.count]];
+		for (int i = 0; i < level.count; ++i)
+		{
+			for (size_t j = 0; j < neighbors[i].size(); ++j)
+			{
+				level.adjacency[level.offsets[i] + j] = neighbors[i][j];
+			}
+		}
+		return level;
+	}
+	//Every triangle of the removed vertex's neighbors that it sees, with no other neighbor in front, is a face of the next level
+	void patchHole(const std::vector<int>& ids, std::vector<std::vector<int>>& neighbors, int removed) const
+	{
+		const std::vector<int>& ring = neighbors[removed];
+		const tvec3<T>& apex = shape->vertices[ids[removed]];
+		int valence = static_cast<int>(ring.size());
+		for (int a = 0; a < valence; ++a)
+		{
+			const tvec3<T>& A = shape->vertices[ids[ring[a]]];
+			for (int b = a + 1; b < valence; ++b)
+			{
+				for (int c = b + 1; c < valence; ++c)
+				{
+					tvec3<T> normal = cross(shape->vertices[ids[ring[b]]] - A, shape->vertices[ids[ring[c]]] - A);
+					T apexSide = dot(apex - A, normal);
+					if (apexSide == T(0))continue;
+					if (apexSide < T(0))normal = T(-1) * normal;
+					T normalLength = std::sqrt(dot(normal, normal));
+					bool face = true;
+					for (int d = 0; d < valence && face; ++d)
+					{
+						if (d == a || d == b || d == c)continue;
+						tvec3<T> offset = shape->vertices[ids[ring[d]]] - A;
+						if (dot(offset, normal) > T(0.0001) * normalLength * std::sqrt(dot(offset, offset)))face = false;
+					}
+					if (!face)continue;
+					connect(neighbors, ring[a], ring[b]);
+					connect(neighbors, ring[b], ring[c]);
+					connect(neighbors, ring[a], ring[c]);
+				}
+			}
+		}
+	}
+	static void connect(std::vector<std::vector<int>>& neighbors, int a, int b)
+	{
+		for (int n : neighbors[a])
+		{
+			if (n == b)return;
+		}
+		neighbors[a].push_back(b);
+		neighbors[b].push_back(a);
+	}
+	void release()
+	{
+		for (int i = 0; i < levelCount; ++i)
+		{
+			delete[] levels[i].vertexIds;
+			delete[] levels[i].offsets;
+			delete[] levels[i].adjacency;
+			if (levels[i].down != nullptr)delete[] levels[i].down;
+		}
+		if (levels != nullptr)
+		{
+			delete[] levels;
+			levels = nullptr;
+		}
+		levelCount = 0;
+	}
+	const tShape<T>* shape = nullptr;
+	Level* levels = nullptr;
+	int levelCount = 0;
+};
+
+typedef tSupportHierarchy<float> SupportHierarchy;
+
+#endif
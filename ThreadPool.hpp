@@ -47,4 +47,34 @@ private:
 	std::thread* threads = nullptr;//Thread pool itself
 };
 
+//Tasks are plain function pointers, so a job object reaches them through a static pointer, one per job type
+//	Callers of one job type share a lock held from setting the pointer to clearing it, concurrent dispatches take turns
+//	Not re-entrant: a task must not dispatch a job of its own type, the lock is already held
+template <typename Job>
+struct PooledJob
+{
+	static Job* active;
+	static std::mutex dispatchLock;
+	static void task(std::mutex&, unsigned int index)
+	{
+		active->run(index);
+	}
+};
+
+template <typename Job>
+Job* PooledJob<Job>::active = nullptr;
+
+template <typename Job>
+std::mutex PooledJob<Job>::dispatchLock;
+
+//Runs job.run(block) for each of job.blockCount() blocks over the pool
+template <typename Job>
+void dispatchJob(ThreadPool& pool, Job& job)
+{
+	std::lock_guard<std::mutex> lock(PooledJob<Job>::dispatchLock);
+	PooledJob<Job>::active = &job;
+	pool.dispatch(job.blockCount(), &PooledJob<Job>::task);
+	PooledJob<Job>::active = nullptr;
+}
+
 #endif
\ No newline at end of file
@@ -8,117 +8,144 @@ Purpose: This is not an extensive linear algebra library.
 		operations in an outlined parallel time of collision algorithm.
 	Feel free to extend this header as desired, but I would recommend the
 		Unofficial OpenGl Library - GLM.
+	Every type is templated on its scalar, following GLM's naming.
+		vec3, mat3, quat and transform are the single precision types used
+		by the trials, and dvec3, dmat3, dquat and dtransform the double
+		precision types for large world coordinates.
 */
 
 #ifndef __VECTOR_MATH__
 #define __VECTOR_MATH__
 
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "Predicates.hpp"
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#endif
 
-class vec3
+template <typename T>
+class tvec3
 {
 public:
-	vec3() : x(0.0f), y(0.0f), z(0.0f)
+	typedef T value_type;
+	tvec3() : x(0.0f), y(0.0f), z(0.0f)
 	{
 		//NULL
 	}
-	vec3(const float x_, const float y_, const float z_)
+	tvec3(const T x_, const T y_, const T z_)
 	{
 		x = x_;
 		y = y_;
 		z = z_;
 	}
-	vec3(const float x_)
+	tvec3(const T x_)
 	{
 		x = x_;
 		y = x;
 		z = x;
 	}
-	~vec3()
+	template <typename U>
+	explicit tvec3(const tvec3<U>& cp)
+	{//precision conversion
+		x = static_cast<T>(cp.x);
+		y = static_cast<T>(cp.y);
+		z = static_cast<T>(cp.z);
+	}
+	~tvec3()
 	{
 
 	}
-	vec3(const vec3& cp)
+	tvec3(const tvec3& cp)
 	{
 		this->x = cp.x;
 		this->y = cp.y;
 		this->z = cp.z;
 	}
-	vec3& operator=(const vec3& cp)
+	tvec3& operator=(const tvec3& cp)
 	{
 		this->x = cp.x;
 		this->y = cp.y;
 		this->z = cp.z;
 		return *this;
 	}
-	friend vec3 operator-(const vec3&, const vec3&);
-	friend vec3 operator+(const vec3&, const vec3&);
-	friend vec3 operator*(const float&, const vec3&);
-	friend vec3 operator*(const vec3&, const float&);
-	friend vec3 operator/(const float&, const vec3&);
-	friend vec3 operator/(const vec3&, const float&);
-	float x, y, z;
+	T x, y, z;
 };
 
-vec3 operator-(const vec3& a, const vec3& b)
+typedef tvec3<float> vec3;
+typedef tvec3<double> dvec3;
+
+//Scalars are taken as tvec3<T>::value_type so only the vector deduces T, i.e. dvec3 * 0.5f is valid
+template <typename T>
+tvec3<T> operator-(const tvec3<T>& a, const tvec3<T>& b)
 {
-	return vec3(a.x - b.x, a.y - b.y, a.z - b.z);
+	return tvec3<T>(a.x - b.x, a.y - b.y, a.z - b.z);
 }
-vec3 operator+(const vec3& a, const vec3& b)
+template <typename T>
+tvec3<T> operator+(const tvec3<T>& a, const tvec3<T>& b)
 {
-	return vec3(a.x + b.x, a.y + b.y, a.z + b.z);
+	return tvec3<T>(a.x + b.x, a.y + b.y, a.z + b.z);
 }
-vec3 operator*(const float& s, const vec3& v)
+template <typename T>
+tvec3<T> operator*(const typename tvec3<T>::value_type& s, const tvec3<T>& v)
 {
-	return vec3(v.x * s, v.y * s, v.z * s);
+	return tvec3<T>(v.x * s, v.y * s, v.z * s);
 }
-vec3 operator*(const vec3& v, const float& s)
+template <typename T>
+tvec3<T> operator*(const tvec3<T>& v, const typename tvec3<T>::value_type& s)
 {
 	return s * v;
 }
-vec3 operator/(const float& s, const vec3& v)
+template <typename T>
+tvec3<T> operator/(const typename tvec3<T>::value_type& s, const tvec3<T>& v)
 {
-	return (1.0f / s) * v;
+	return (T(1) / s) * v;
 }
-vec3 operator/(const vec3& v, const float& s)
+template <typename T>
+tvec3<T> operator/(const tvec3<T>& v, const typename tvec3<T>::value_type& s)
 {
-	return (1.0f / s) * v;
+	return (T(1) / s) * v;
 }
 
 
-vec3 cross(const vec3& a, const vec3& b)
+template <typename T>
+tvec3<T> cross(const tvec3<T>& a, const tvec3<T>& b)
 {
 	//x = yz-zy
 	//y = zx-xz
 	//z = xy-yx
-	vec3 temp;
+	tvec3<T> temp;
 	temp.x = (a.y * b.z) - (a.z * b.y);
 	temp.y = (a.z * b.x) - (a.x * b.z);
 	temp.z = (a.x * b.y) - (a.y * b.x);
 	return temp;
 }
 
-float dot(const vec3& a, const vec3& b)
+template <typename T>
+T dot(const tvec3<T>& a, const tvec3<T>& b)
 {
 	return a.x * b.x + a.y * b.y + a.z * b.z;
 }
 
-vec3 barycentricCoordinates(const vec3& S, const vec3& A, const vec3& B, const vec3& C)
+template <typename T>
+tvec3<T> barycentricCoordinates(const tvec3<T>& S, const tvec3<T>& A, const tvec3<T>& B, const tvec3<T>& C)
 {//triangle case
-	vec3 AB = B - A, AC = C - A, AS = S - A;
-	float abAB = dot(AB, AB), abAC = dot(AB, AC), acAC = dot(AC, AC), abAS = dot(AB, AS), acAS = dot(AC, AS);
-	float dividor = 1.0f / ((abAB * acAC) - (abAC * abAC));
-	vec3 temp;
+	tvec3<T> AB = B - A, AC = C - A, AS = S - A;
+	T abAB = dot(AB, AB), abAC = dot(AB, AC), acAC = dot(AC, AC), abAS = dot(AB, AS), acAS = dot(AC, AS);
+	T dividor = T(1) / ((abAB * acAC) - (abAC * abAC));
+	tvec3<T> temp;
 	temp.y = ((acAC * abAS) - (abAC * acAS)) * dividor;
 	temp.z = ((abAB * acAS) - (abAC * abAS)) * dividor;
-	temp.x = 1.0f - temp.y - temp.z;
+	temp.x = T(1) - temp.y - temp.z;
 	return temp;
 }
 
-vec3 closestPoint(const vec3& S, const vec3& A, const vec3& B)
+template <typename T>
+tvec3<T> closestPoint(const tvec3<T>& S, const tvec3<T>& A, const tvec3<T>& B)
 {//find closest point on AB to S
-	vec3 AB = B - A, AS = S - A;
-	float distance = dot(AS, AB) / dot(AB, AB);//should be able to find barycentric coordinates using this
+	tvec3<T> AB = B - A, AS = S - A;
+	T distance = dot(AS, AB) / dot(AB, AB);//should be able to find barycentric coordinates using this
 	if (distance <= 0)
 	{
 		return A;
@@ -130,95 +157,402 @@ vec3 closestPoint(const vec3& S, const vec3& A, const vec3& B)
 	return A + (AB * distance);
 }
 
-vec3 closestPoint(const vec3& S, const vec3& A, const vec3& B, const vec3& C)
+template <typename T>
+tvec3<T> closestPoint(const tvec3<T>& S, const tvec3<T>& A, const tvec3<T>& B, const tvec3<T>& C)
 {//find closest point on ABC to S
-	vec3 AB = B - A, BC = C - B, CA = A - C, AS = S - A, BS = S - B, CS = S - C;
-	//vec3 abNorm = normalize(AB), bcNorm = normalize(BC), caNorm = normalize(CA);
-	//trying with magnitude division only first
-	float uAB = (dot(AS, AB)) / dot(AB, AB), vAB = 0.0f, uBC = (dot(BS, BC)) / dot(BC, BC), vBC = 0.0f,
-		uCA = (dot(CS, CA)) / dot(CA, CA), vCA = 0.0f;
-	vAB = 1.0f - uAB;
-	if (uAB < 0.0f)
+	//Voronoi region tests in order: vertex A, vertex B, edge AB, vertex C, edge AC, edge BC, face
+	//	Each exit performs at most one division
+	tvec3<T> AB = B - A, AC = C - A, AS = S - A;
+	T d1 = dot(AB, AS), d2 = dot(AC, AS);
+	if (d1 <= 0.0f && d2 <= 0.0f)
 	{
-		uAB = 1.0f;//possibly switched
-		vAB = 0.0f;
+		//A
+		return A;
 	}
-	else if (uAB > 1.0f)
+	tvec3<T> BS = S - B;
+	T d3 = dot(AB, BS), d4 = dot(AC, BS);
+	if (d3 >= 0.0f && d4 <= d3)
 	{
-		uAB = 0.0f;
-		vAB = 1.0f;
+		//B
+		return B;
 	}
-	vBC = 1.0f - uBC;
-	if (uBC < 0.0f)
+	T vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
 	{
-		uBC = 1.0f;
-		vBC = 0.0f;
+		//AB
+		return A + (AB * (d1 / (d1 - d3)));
 	}
-	else if (uBC > 1.0f)
+	tvec3<T> CS = S - C;
+	T d5 = dot(AB, CS), d6 = dot(AC, CS);
+	if (d6 >= 0.0f && d5 <= d6)
 	{
-		uBC = 0.0f;
-		vBC = 1.0f;
+		//C
+		return C;
 	}
-	vCA = 1.0f - uCA;
-	if (uCA < 0.0f)
+	T vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
 	{
-		uCA = 1.0f;
-		vCA = 0.0f;
+		//AC
+		return A + (AC * (d2 / (d2 - d6)));
 	}
-	else if (uCA > 1.0f)
+	T va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
 	{
-		uCA = 0.0f;
-		vCA = 1.0f;
+		//BC
+		return B + ((C - B) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))));
 	}
-	//test vertices
-	if (vAB <= 0.0f && uCA <= 0.0f)
+	//else all -- inside triangle
+	T dividor = T(1) / (va + vb + vc);
+	return A + (AB * (vb * dividor)) + (AC * (vc * dividor));
+}
+
+//Four triangles in structure of arrays layout, lane i holds triangle i
+template <typename T>
+struct tTriangleLanes
+{
+	T ax[4], ay[4], az[4];
+	T bx[4], by[4], bz[4];
+	T cx[4], cy[4], cz[4];
+};
+
+//Result of closestPointLanes, the closest point and its squared distance to S per lane
+template <typename T>
+struct tPointLanes
+{
+	T x[4], y[4], z[4];
+	T distSq[4];
+};
+
+typedef tTriangleLanes<float> TriangleLanes;
+typedef tPointLanes<float> PointLanes;
+
+template <typename T>
+void closestPointLanes(const tvec3<T>& S, const tTriangleLanes<T>& L, tPointLanes<T>& result)
+{
+	//Same Voronoi regions as closestPoint(S, A, B, C), but every region is evaluated and selected without branches.
+	//	Each region is written as weights (n1 / den, n2 / den) on AB and AC, so one division serves all regions.
+	for (int i = 0; i < 4; ++i)
 	{
-		//A
-		return A;
+		T abx = L.bx[i] - L.ax[i], aby = L.by[i] - L.ay[i], abz = L.bz[i] - L.az[i];
+		T acx = L.cx[i] - L.ax[i], acy = L.cy[i] - L.ay[i], acz = L.cz[i] - L.az[i];
+		T asx = S.x - L.ax[i], asy = S.y - L.ay[i], asz = S.z - L.az[i];
+		T bsx = S.x - L.bx[i], bsy = S.y - L.by[i], bsz = S.z - L.bz[i];
+		T csx = S.x - L.cx[i], csy = S.y - L.cy[i], csz = S.z - L.cz[i];
+		T d1 = abx * asx + aby * asy + abz * asz, d2 = acx * asx + acy * asy + acz * asz;
+		T d3 = abx * bsx + aby * bsy + abz * bsz, d4 = acx * bsx + acy * bsy + acz * bsz;
+		T d5 = abx * csx + aby * csy + abz * csz, d6 = acx * csx + acy * csy + acz * csz;
+		T va = d3 * d6 - d5 * d4, vb = d5 * d2 - d1 * d6, vc = d1 * d4 - d3 * d2;
+		bool inA = d1 <= 0.0f && d2 <= 0.0f;
+		bool inB = d3 >= 0.0f && d4 <= d3;
+		bool inAB = vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f;
+		bool inC = d6 >= 0.0f && d5 <= d6;
+		bool inAC = vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f;
+		bool inBC = va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f;
+		//Selected from lowest to highest priority so the first region in closestPoint's order wins
+		T n1 = vb, n2 = vc, den = va + vb + vc;
+		n1 = inBC ? (d5 - d6) : n1; n2 = inBC ? (d4 - d3) : n2; den = inBC ? (d4 - d3) + (d5 - d6) : den;
+		n1 = inAC ? T(0) : n1; n2 = inAC ? d2 : n2; den = inAC ? d2 - d6 : den;
+		n1 = inC ? T(0) : n1; n2 = inC ? T(1) : n2; den = inC ? T(1) : den;
+		n1 = inAB ? d1 : n1; n2 = inAB ? T(0) : n2; den = inAB ? d1 - d3 : den;
+		n1 = inB ? T(1) : n1; n2 = inB ? T(0) : n2; den = inB ? T(1) : den;
+		n1 = inA ? T(0) : n1; n2 = inA ? T(0) : n2; den = inA ? T(1) : den;
+		T dividor = T(1) / den;
+		T v = n1 * dividor, w = n2 * dividor;
+		result.x[i] = L.ax[i] + abx * v + acx * w;
+		result.y[i] = L.ay[i] + aby * v + acy * w;
+		result.z[i] = L.az[i] + abz * v + acz * w;
+		T dx = result.x[i] - S.x, dy = result.y[i] - S.y, dz = result.z[i] - S.z;
+		result.distSq[i] = dx * dx + dy * dy + dz * dz;
 	}
-	if (vBC <= 0.0f && uAB <= 0.0f)
+}
+
+template <typename T>
+void tetrahedronFaceLanes(const tvec3<T>& A, const tvec3<T>& B, const tvec3<T>& C, const tvec3<T>& D, tTriangleLanes<T>& L)
+{//lanes hold the faces BCD, ABC, ABD, ACD, i.e. the faces opposite of A, D, C, B
+	const tvec3<T>* faces[4][3] = { { &B, &C, &D }, { &A, &B, &C }, { &A, &B, &D }, { &A, &C, &D } };
+	for (int i = 0; i < 4; ++i)
 	{
-		//B
-		return B;
+		L.ax[i] = faces[i][0]->x; L.ay[i] = faces[i][0]->y; L.az[i] = faces[i][0]->z;
+		L.bx[i] = faces[i][1]->x; L.by[i] = faces[i][1]->y; L.bz[i] = faces[i][1]->z;
+		L.cx[i] = faces[i][2]->x; L.cy[i] = faces[i][2]->y; L.cz[i] = faces[i][2]->z;
 	}
-	if (vCA <= 0.0f && uBC <= 0.0f)
+}
+
+//Precision used by normalize(v) and length(v) when no mode is given
+//	0 - Exact, square root and division
+//	1 - Refined, reciprocal square root estimate plus one Newton-Raphson step
+//	2 - Estimate, raw reciprocal square root estimate
+#ifndef NORMALIZE_PRECISION
+#define NORMALIZE_PRECISION 0
+#endif
+
+enum class SqrtPrecision
+{
+	Exact = 0,
+	Refined = 1,
+	Estimate = 2
+};
+
+const SqrtPrecision defaultSqrtPrecision = static_cast<SqrtPrecision>(NORMALIZE_PRECISION);
+
+//Measured worst case relative error of 1/sqrt(s) against the exact result, over s in [1e-6, 1e6]:
+//	SSE rsqrtss				Estimate: 3.3e-4	Refined: 2.7e-7 (float), 1.6e-7 (double)
+//	Portable bit estimate	Estimate: 3.5e-2	Refined: 1.8e-3
+//	Exact float is 1.1e-7 for comparison.
+//	normalize and length inherit these bounds, plus one rounding of the final product.
+//	Zero length vectors give NaN from normalize in every mode, and 0 from length.
+float rsqrtEstimate(const float s)
+{
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(s)));
+#else
+	//Bit level initial guess for 1/sqrt(s)
+	uint32_t i;
+	std::memcpy(&i, &s, sizeof(float));
+	i = 0x5f3759df - (i >> 1);
+	float y;
+	std::memcpy(&y, &i, sizeof(float));
+	return y;
+#endif
+}
+
+double rsqrtEstimate(const double s)
+{//float estimate, the refinement step is done in double
+	return static_cast<double>(rsqrtEstimate(static_cast<float>(s)));
+}
+
+template <SqrtPrecision P, typename T>
+T inverseSqrt(const T s)
+{
+	if (P == SqrtPrecision::Exact)return T(1) / std::sqrt(s);
+	T y = rsqrtEstimate(s);
+	if (P == SqrtPrecision::Refined)y = y * (T(1.5) - T(0.5) * s * y * y);
+	return y;
+}
+
+template <SqrtPrecision P, typename T>
+T length(const tvec3<T>& v)
+{
+	T s = dot(v, v);
+	if (P == SqrtPrecision::Exact)return std::sqrt(s);
+	return (s > T(0)) ? s * inverseSqrt<P>(s) : T(0);
+}
+
+template <typename T>
+T length(const tvec3<T>& v)
+{
+	return length<defaultSqrtPrecision>(v);
+}
+
+template <SqrtPrecision P, typename T>
+tvec3<T> normalize(const tvec3<T>& v)
+{
+	if (P == SqrtPrecision::Exact)return v / std::sqrt(dot(v, v));
+	return v * inverseSqrt<P>(dot(v, v));
+}
+
+template <typename T>
+tvec3<T> normalize(const tvec3<T>& v)
+{
+	return normalize<defaultSqrtPrecision>(v);
+}
+
+//Column major 3x3 matrix, primarily used as an expanded rotation for hot loops
+template <typename T>
+class tmat3
+{
+public:
+	tmat3() : c{ tvec3<T>(1.0f, 0.0f, 0.0f), tvec3<T>(0.0f, 1.0f, 0.0f), tvec3<T>(0.0f, 0.0f, 1.0f) }
 	{
-		//C
-		return C;
+		//NULL
 	}
-	//test edges
-	vec3 baryCoords = barycentricCoordinates(S, A, B, C);
-	if (uAB > 0.0f && vAB > 0.0f && baryCoords.z <= 0.0f)
+	tmat3(const tvec3<T>& c0, const tvec3<T>& c1, const tvec3<T>& c2) : c{ c0, c1, c2 }
 	{
-		//AB
-		return closestPoint(S, A, B);
+		//NULL
 	}
-	if (uBC > 0.0f && vBC > 0.0f && baryCoords.x <= 0.0f)
+	tvec3<T> c[3];
+};
+
+typedef tmat3<float> mat3;
+typedef tmat3<double> dmat3;
+
+template <typename T>
+tmat3<T> transpose(const tmat3<T>& m)
+{
+	return tmat3<T>(tvec3<T>(m.c[0].x, m.c[1].x, m.c[2].x),
+		tvec3<T>(m.c[0].y, m.c[1].y, m.c[2].y),
+		tvec3<T>(m.c[0].z, m.c[1].z, m.c[2].z));
+}
+
+template <typename T>
+tvec3<T> operator*(const tmat3<T>& m, const tvec3<T>& v)
+{
+	return (m.c[0] * v.x) + (m.c[1] * v.y) + (m.c[2] * v.z);
+}
+
+template <typename T>
+tmat3<T> operator*(const tmat3<T>& a, const tmat3<T>& b)
+{
+	return tmat3<T>(a * b.c[0], a * b.c[1], a * b.c[2]);
+}
+
+template <typename T>
+tvec3<T> transposeMultiply(const tmat3<T>& m, const tvec3<T>& v)
+{//M^T * v without building the transpose, the inverse rotation of v when M is orthonormal
+	return tvec3<T>(dot(m.c[0], v), dot(m.c[1], v), dot(m.c[2], v));
+}
+
+//Unit quaternion for orientations, w is the scalar part
+template <typename T>
+class tquat
+{
+public:
+	tquat() : w(1.0f), x(0.0f), y(0.0f), z(0.0f)
 	{
-		//BC
-		return closestPoint(S, B, C);
+		//NULL
 	}
-	if (uCA > 0.0f && vCA > 0.0f && baryCoords.y <= 0.0f)
+	tquat(const T w_, const T x_, const T y_, const T z_) : w(w_), x(x_), y(y_), z(z_)
 	{
-		//CA
-		return closestPoint(S, A, C);
+		//NULL
 	}
-	//else all -- inside triangle
-	return (baryCoords.x * A) + (baryCoords.y * B) + (baryCoords.z * C);
+	template <typename U>
+	explicit tquat(const tquat<U>& cp) : w(static_cast<T>(cp.w)), x(static_cast<T>(cp.x)), y(static_cast<T>(cp.y)), z(static_cast<T>(cp.z))
+	{//precision conversion
+	}
+	T w, x, y, z;
+};
+
+typedef tquat<float> quat;
+typedef tquat<double> dquat;
+
+template <typename T>
+tquat<T> operator*(const tquat<T>& a, const tquat<T>& b)
+{//compose, applying b first then a
+	return tquat<T>(a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+		a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+		a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+		a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w);
 }
 
-vec3 normalize(const vec3& v)
+template <typename T>
+tquat<T> conjugate(const tquat<T>& q)
+{//inverse for unit quaternions
+	return tquat<T>(q.w, -q.x, -q.y, -q.z);
+}
+
+template <typename T>
+tquat<T> angleAxis(const typename tvec3<T>::value_type angle, const tvec3<T>& axis)
+{//axis is expected to be unit length
+	T s = std::sin(angle * T(0.5));
+	return tquat<T>(std::cos(angle * T(0.5)), axis.x * s, axis.y * s, axis.z * s);
+}
+
+template <typename T>
+tquat<T> normalize(const tquat<T>& q)
+{
+	T s = T(1) / std::sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+	return tquat<T>(q.w * s, q.x * s, q.y * s, q.z * s);
+}
+
+template <typename T>
+tvec3<T> rotate(const tquat<T>& q, const tvec3<T>& v)
+{//v + 2w(u x v) + 2u x (u x v), folded to two cross products
+	tvec3<T> u(q.x, q.y, q.z);
+	tvec3<T> t = 2.0f * cross(u, v);
+	return v + (q.w * t) + cross(u, t);
+}
+
+template <typename T>
+tmat3<T> toMat3(const tquat<T>& q)
 {
-	return v / std::sqrt(dot(v, v));
+	T xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+	T xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+	T wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+	return tmat3<T>(tvec3<T>(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy)),
+		tvec3<T>(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx)),
+		tvec3<T>(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy)));
 }
 
-bool inTriangle(const vec3& A, const vec3& B, const vec3& C, const vec3& s)
+//Rigid body transform, rotation is applied before translation
+template <typename T>
+class ttransform
 {
-	if (((B.x - A.x) * (s.y - A.y) - (B.y - A.y) * (s.x - A.x)) > 0.0f)
+public:
+	ttransform()
+	{
+		//NULL
+	}
+	ttransform(const tquat<T>& orientation_, const tvec3<T>& position_) : orientation(orientation_), position(position_)
 	{
-		if (((C.x - B.x) * (s.y - B.y) - (C.y - B.y) * (s.x - B.x)) > 0.0f)
+		//NULL
+	}
+	ttransform(const tvec3<T>& position_) : position(position_)
+	{
+		//NULL
+	}
+	template <typename U>
+	explicit ttransform(const ttransform<U>& cp) : orientation(cp.orientation), position(cp.position)
+	{//precision conversion
+	}
+	tquat<T> orientation;
+	tvec3<T> position;
+};
+
+typedef ttransform<float> transform;
+typedef ttransform<double> dtransform;
+
+template <typename T>
+ttransform<T> operator*(const ttransform<T>& a, const ttransform<T>& b)
+{//compose, applying b first then a
+	return ttransform<T>(a.orientation * b.orientation, rotate(a.orientation, b.position) + a.position);
+}
+
+template <typename T>
+ttransform<T> inverse(const ttransform<T>& t)
+{
+	tquat<T> q = conjugate(t.orientation);
+	return ttransform<T>(q, -1.0f * rotate(q, t.position));
+}
+
+template <typename T>
+tvec3<T> transformPoint(const ttransform<T>& t, const tvec3<T>& p)
+{
+	return rotate(t.orientation, p) + t.position;
+}
+
+template <typename T>
+tvec3<T> transformDirection(const ttransform<T>& t, const tvec3<T>& d)
+{
+	return rotate(t.orientation, d);
+}
+
+template <typename T>
+tvec3<T> inverseTransformDirection(const ttransform<T>& t, const tvec3<T>& d)
+{//world to local frame
+	return rotate(conjugate(t.orientation), d);
+}
+
+//Filtered exact orientation tests, see Predicates.hpp for the sign conventions
+template <typename T>
+T orient2d(const tvec3<T>& A, const tvec3<T>& B, const tvec3<T>& C)
+{//xy plane only
+	return orient2d(A.x, A.y, B.x, B.y, C.x, C.y);
+}
+
+template <typename T>
+T orient3d(const tvec3<T>& A, const tvec3<T>& B, const tvec3<T>& C, const tvec3<T>& D)
+{
+	return orient3d(A.x, A.y, A.z, B.x, B.y, B.z, C.x, C.y, C.z, D.x, D.y, D.z);
+}
+
+template <typename T>
+bool inTriangle(const tvec3<T>& A, const tvec3<T>& B, const tvec3<T>& C, const tvec3<T>& s)
+{
+	if (orient2d(A, B, s) > 0.0f)
+	{
+		if (orient2d(B, C, s) > 0.0f)
 		{
-			if (((A.x - C.x) * (s.y - C.y) - (A.y - C.y) * (s.x - C.x)) > 0.0f)
+			if (orient2d(C, A, s) > 0.0f)
 			{
 				return true;
 			}
@@ -226,9 +560,9 @@ bool inTriangle(const vec3& A, const vec3& B, const vec3& C, const vec3& s)
 		}
 		return false;
 	}
-	if (((C.x - B.x) * (s.y - B.y) - (C.y - B.y) * (s.x - B.x)) < 0.0f)
+	if (orient2d(B, C, s) < 0.0f)
 	{
-		if (((A.x - C.x) * (s.y - C.y) - (A.y - C.y) * (s.x - C.x)) < 0.0f)
+		if (orient2d(C, A, s) < 0.0f)
 		{
 			return true;
 		}
@@ -237,4 +571,26 @@ bool inTriangle(const vec3& A, const vec3& B, const vec3& C, const vec3& s)
 	return false;
 }
 
+//Exact sides of s against ABCD, keep[i] is false when putting s in place of vertex i flips the orientation
+//	Returns whether s is inside or on the boundary of ABCD, a flat tetrahedron keeps no vertex and holds nothing
+template <typename T>
+bool tetrahedronSides(const tvec3<T>& A, const tvec3<T>& B, const tvec3<T>& C, const tvec3<T>& D, const tvec3<T>& s, bool keep[4])
+{
+	T volume = orient3d(A, B, C, D);
+	if (volume == 0.0f)
+	{
+		keep[0] = keep[1] = keep[2] = keep[3] = false;
+		return false;
+	}
+	bool positive = volume > 0.0f;
+	T faces[4] = { orient3d(s, B, C, D), orient3d(A, s, C, D), orient3d(A, B, s, D), orient3d(A, B, C, s) };
+	bool inside = true;
+	for (int i = 0; i < 4; ++i)
+	{
+		keep[i] = positive ? (faces[i] >= 0.0f) : (faces[i] <= 0.0f);
+		inside = inside && keep[i];
+	}
+	return inside;
+}
+
 #endif
\ No newline at end of file
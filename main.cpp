@@ -29,10 +29,19 @@ Purpose: This research is meant to be both an exercise in mathematics and parall
 #include <chrono>
 #include <utility>
 #include "ThreadPool.hpp"
+#include "Body.hpp"
+#include "CollisionLod.hpp"
+#include "Compound.hpp"
+#include "EPA.hpp"
+#include "GaussMap.hpp"
 #include "GJK.hpp"
+#include "HalfEdge.hpp"
+#include "ImplicitShapes.hpp"
 #include "VectorMath.hpp"
 #include "Meshes.hpp"
+#include "QuantizedShape.hpp"
 #include "Shape.hpp"
+#include "SupportHierarchy.hpp"
 
 //Hello World style Parallel Task - Dot product
 float vectorA[14] = { 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f, 0.8f, 0.9f, 0.12f, 0.13f, 0.14f, 0.15f, 0.16f };
@@ -70,9 +79,19 @@ void hyperplaneCubeAllFacesToI(std::mutex& m, unsigned int index)
 {
 	float min = 1000.0f;
 	vec3 displaced = cube.vertices[index] + translation;
+	//The vertex's path misses the mesh's cached box, so no face can be hit
+	const Bounds& bounds = cube.getBounds();
+	if (!segmentHitsBox(displaced, velocity, bounds.minimum, bounds.maximum))
+	{
+		projTimes[index] = min;
+		return;
+	}
+	//Constant for every face, so normalized once per vertex rather than per face
+	//	NORMALIZE_PRECISION selects the exact or reciprocal square root path
+	vec3 direction = normalize(velocity);
 	for (int i = 0; i < cube.faceCount; ++i)
 	{
-		float normalVelocity = dot(cube.faces[i], normalize(velocity));
+		float normalVelocity = dot(cube.faces[i], direction);
 		if (normalVelocity < 0.000001f)continue;
 		//Moller-Trumbore ray triangle intersection
 		const vec3& A = cube.faceEdges[i].edge[0];
@@ -105,9 +124,16 @@ void hyperplaneSuzanneAllFacesToI(std::mutex& m, unsigned int index)
 {
 	float min = 1000.0f;
 	vec3 displaced = suzanne.vertices[index] + translation;
+	const Bounds& bounds = suzanne.getBounds();
+	if (!segmentHitsBox(displaced, velocity, bounds.minimum, bounds.maximum))
+	{
+		projTimes[index] = min;
+		return;
+	}
+	vec3 direction = normalize(velocity);
 	for (int i = 0; i < suzanne.faceCount; ++i)
 	{
-		float normalVelocity = dot(suzanne.faces[i], normalize(velocity));
+		float normalVelocity = dot(suzanne.faces[i], direction);
 		if (normalVelocity < 0.000001f)continue;
 		//Moller-Trumbore ray triangle intersection
 		const vec3& A = suzanne.faceEdges[i].edge[0];
@@ -140,9 +166,16 @@ void hyperplaneSphereAllFacesToI(std::mutex& m, unsigned int index)
 {
 	float min = 1000.0f;
 	vec3 displaced = sphere.vertices[index] + translation;
+	const Bounds& bounds = sphere.getBounds();
+	if (!segmentHitsBox(displaced, velocity, bounds.minimum, bounds.maximum))
+	{
+		projTimes[index] = min;
+		return;
+	}
+	vec3 direction = normalize(velocity);
 	for (int i = 0; i < sphere.faceCount; ++i)
 	{
-		float normalVelocity = dot(sphere.faces[i], normalize(velocity));
+		float normalVelocity = dot(sphere.faces[i], direction);
 		if (normalVelocity < 0.0001f)continue;
 		//Moller-Trumbore ray triangle intersection
 		const vec3& A = sphere.faceEdges[i].edge[0];
@@ -171,6 +204,19 @@ void hyperplaneSphereAllFacesToI(std::mutex& m, unsigned int index)
 	projTimes[index] = min;
 }
 
+CollisionLods sphereLods;
+//Vertices whose path misses the sphere's coarsest enclosing proxy skip the face loop
+void hyperplaneSphereLodToI(std::mutex& m, unsigned int index)
+{
+	vec3 displaced = sphere.vertices[index] + translation;
+	if (!segmentHitsHull(displaced, velocity, sphereLods.coarsest()))
+	{
+		projTimes[index] = 1000.0f;
+		return;
+	}
+	hyperplaneSphereAllFacesToI(m, index);
+}
+
 bool validFaces[480];
 void hyperplaneCullSuzanne(std::mutex& m, unsigned int index)
 {
@@ -201,9 +247,16 @@ void hyperplaneReducedSuzanne(std::mutex& m, unsigned int index)
 {
 	float min = 1000.0f;
 	vec3 displaced = suzanne.vertices[index] + translation;
+	const Bounds& bounds = suzanne.getBounds();
+	if (!segmentHitsBox(displaced, velocity, bounds.minimum, bounds.maximum))
+	{
+		projTimes[index] = min;
+		return;
+	}
+	vec3 direction = normalize(velocity);
 	for (int i = 0; i < testCount; ++i)
 	{
-		float normalVelocity = dot(suzanne.faces[testFaces[i]], normalize(velocity));
+		float normalVelocity = dot(suzanne.faces[testFaces[i]], direction);
 		if (normalVelocity < 0.0001f)continue;
 		//Moller-Trumbore ray triangle intersection
 		const vec3& A = suzanne.faceEdges[testFaces[i]].edge[0];
@@ -236,9 +289,16 @@ void hyperplaneReducedSphere(std::mutex& m, unsigned int index)
 {
 	float min = 1000.0f;
 	vec3 displaced = sphere.vertices[index] + translation;
+	const Bounds& bounds = sphere.getBounds();
+	if (!segmentHitsBox(displaced, velocity, bounds.minimum, bounds.maximum))
+	{
+		projTimes[index] = min;
+		return;
+	}
+	vec3 direction = normalize(velocity);
 	for (int i = 0; i < testCount; ++i)
 	{
-		float normalVelocity = dot(sphere.faces[testFaces[i]], normalize(velocity));
+		float normalVelocity = dot(sphere.faces[testFaces[i]], direction);
 		if (normalVelocity < 0.0001f)continue;
 		//Moller-Trumbore ray triangle intersection
 		const vec3& A = sphere.faceEdges[testFaces[i]].edge[0];
@@ -267,6 +327,92 @@ void hyperplaneReducedSphere(std::mutex& m, unsigned int index)
 	projTimes[index] = min;
 }
 
+QuantizedShape quantizedSphere;
+void hyperplaneQuantizedSphereAllFacesToI(std::mutex& m, unsigned int index)
+{
+	float min = 1000.0f;
+	vec3 displaced = quantizedSphere.getVertex(index) + translation;
+	const Bounds& bounds = quantizedSphere.getBounds();
+	if (!segmentHitsBox(displaced, velocity, bounds.minimum, bounds.maximum))
+	{
+		projTimes[index] = min;
+		return;
+	}
+	for (int i = 0; i < quantizedSphere.faceCount; ++i)
+	{
+		//Edges come from the dequantized corners instead of stored faceEdges
+		const Indices3& face = quantizedSphere.faceVerts[i];
+		vec3 P = quantizedSphere.getVertex(face.ind[0]);
+		vec3 A = quantizedSphere.getVertex(face.ind[1]) - P;
+		vec3 B = quantizedSphere.getVertex(face.ind[2]) - P;
+		//Moller-Trumbore ray triangle intersection
+		vec3 h = cross(velocity, B);
+		float a = dot(A, h);
+		//a is -dot(velocity, cross(A, B)), so its sign replaces the stored face normal test
+		if (a > -0.00001f)//Facing away from the velocity or essentially zero
+			continue;
+		float f = 1.0f / a;
+		vec3 s = displaced - P;
+		float u = f * dot(s, h);
+		if (u < 0.0f || u > 1.0f) //Not within the first Barycentric coordinate
+			continue;
+		vec3 q = cross(s, A);
+		float v = f * dot(velocity, q);
+		if (v < 0.0f || (u + v) > 1.0f) //Not within Barycentric bounds
+			continue;
+		float t = f * dot(B, q);
+		if (t > 0.000001f && t < 1.00001f)
+		{
+			//valid ToI
+			if (t < min) min = t;
+		}
+
+	}
+	projTimes[index] = min;
+}
+
+//Times repeated GJK queries at a given precision, with both bodies placed far from the world origin
+template <typename T>
+void precisionTrial(const char* name, const tShape<T>& shape, const tvec3<T>& origin, const tvec3<T>& offset, const tvec3<T>& bVelocity)
+{
+	const unsigned int repeats = 1000;
+	ttransform<T> aTransform(origin), bTransform(origin + offset);
+	uint32_t iterations = 0, bisections = 0;
+	T distance = 0.0f;
+	std::pair<T, T> timeDistance;
+	std::chrono::time_point<std::chrono::steady_clock> startTime = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < repeats; ++i)
+	{
+		distance = gjkDistance(shape, aTransform, shape, bTransform);
+	}
+	uint32_t delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	gjkDistance(shape, shape, ttransform<T>(offset), &iterations);
+	std::cout << name << " distance is: " << distance << " in " << iterations << " iterations, " << repeats << " queries took: " << delta << " microseconds\n";
+	startTime = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < repeats; ++i)
+	{
+		timeDistance = gjkToI(shape, aTransform, shape, bTransform, bVelocity, &bisections);
+	}
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << name << " Time is: " << timeDistance.first << " in " << bisections << " bisections, " << repeats << " queries took: " << delta << " microseconds\n";
+}
+
+//Worst relative error of inverseSqrt against 1/std::sqrt over s in [1e-6, 1e6], the range of the bounds listed in VectorMath.hpp
+template <SqrtPrecision P, typename T>
+double worstInverseSqrtError()
+{
+	const int samples = 1 << 20;
+	double worst = 0.0;
+	for (int i = 0; i <= samples; ++i)
+	{
+		T s = static_cast<T>(std::pow(10.0, -6.0 + 12.0 * i / samples));
+		long double exact = 1.0L / std::sqrt(static_cast<long double>(s));
+		double error = static_cast<double>(std::fabs((static_cast<long double>(inverseSqrt<P>(s)) - exact) / exact));
+		if (error > worst)worst = error;
+	}
+	return worst;
+}
+
 int main()
 {
 	//Create an instance of a Thread Pool, give it the optimal number of available threads minus 1 (to avoid context switching with main thread)
@@ -349,6 +495,19 @@ int main()
 	//Geometric testing begins
 	initShapes();
 	buildFaces();
+	startTime = std::chrono::steady_clock::now();
+	buildHulls(&pool);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Convex hulls took: " << delta << " microseconds, cube (" << cube.count << " vertices, " << cube.faceCount << " faces), suzanne (" << suzanne.count
+		<< " vertices, " << suzanne.faceCount << " faces) and sphere (" << sphere.count << " vertices, " << sphere.faceCount << " faces)\n";
+	sphere.buildSupportCache();
+	quantizedSphere.quantize(sphere);
+	startTime = std::chrono::steady_clock::now();
+	sphereLods.build(sphere);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Sphere collision LODs took: " << delta << " microseconds for " << sphereLods.getLevelCount() << " levels, coarsest has " << sphereLods.coarsest().count << " vertices\n";
+	std::cout << "Mesh arena: " << meshArena.used() << " bytes used of " << meshArena.reserved() << " reserved for cube (" << cube.storageBytes()
+		<< "), suzanne (" << suzanne.storageBytes() << ") and sphere (" << sphere.storageBytes() << ")\n";
 
 	//GJK
 	translation = vec3(5.0f, 0.0f, 0.0f);
@@ -365,6 +524,244 @@ int main()
 	distance = gjkDistance(sphere, sphere, translation);
 	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
 	std::cout << "Sphere to Sphere distance is: " << distance << " and took: " << delta << " microseconds\n";
+	startTime = std::chrono::steady_clock::now();
+	distance = gjkDistance(quantizedSphere, quantizedSphere, translation);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Quantized Sphere to Sphere distance is: " << distance << " (conservatively " << (distance - 2.0f * quantizedSphere.errorBound()) << ") and took: " << delta << " microseconds\n";
+	//Implicit shapes, closed form support functions in place of scanning a tessellation
+	SphereShape implicitSphere(1.0f);
+	BoxShape implicitBox(vec3(1.0f));
+	CapsuleShape implicitCapsule(0.5f, 0.5f);
+	CylinderShape implicitCylinder(1.0f, 1.0f);
+	startTime = std::chrono::steady_clock::now();
+	distance = gjkDistance(implicitSphere, implicitSphere, translation);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Implicit Sphere to Sphere distance is: " << distance << " and took: " << delta << " microseconds\n";
+	startTime = std::chrono::steady_clock::now();
+	distance = gjkDistance(implicitBox, implicitBox, translation);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Implicit Box to Box distance is: " << distance << " and took: " << delta << " microseconds\n";
+	startTime = std::chrono::steady_clock::now();
+	distance = gjkDistance(implicitCapsule, implicitCapsule, translation);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Implicit Capsule to Capsule distance is: " << distance << " and took: " << delta << " microseconds\n";
+	startTime = std::chrono::steady_clock::now();
+	distance = gjkDistance(implicitCylinder, implicitCylinder, translation);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Implicit Cylinder to Cylinder distance is: " << distance << " and took: " << delta << " microseconds\n";
+	startTime = std::chrono::steady_clock::now();
+	distance = gjkDistance(cube, implicitSphere, translation);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Cube to Implicit Sphere distance is: " << distance << " and took: " << delta << " microseconds\n";
+	//Rotated bodies, the support mapping rotates the search direction instead of the mesh
+	transform cubeA(angleAxis(0.785398f, vec3(0.0f, 1.0f, 0.0f)), vec3(0.0f));
+	transform cubeB(angleAxis(0.785398f, vec3(0.0f, 0.0f, 1.0f)), translation);
+	startTime = std::chrono::steady_clock::now();
+	distance = gjkDistance(cube, cubeA, cube, cubeB);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Rotated Cube to Cube distance is: " << distance << " and took: " << delta << " microseconds\n";
+	//Same query keeping the closest points and the features they lie on, in cubeA's frame
+	startTime = std::chrono::steady_clock::now();
+	DistanceResult closestPoints = gjkClosestPoints(cube, cube, inverse(cubeA) * cubeB);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Rotated Cube to Cube closest points are: (" << closestPoints.pointA.x << ", " << closestPoints.pointA.y << ", " << closestPoints.pointA.z << ") and ("
+		<< closestPoints.pointB.x << ", " << closestPoints.pointB.y << ", " << closestPoints.pointB.z << ") from " << closestPoints.featureCount << " simplex vertices after "
+		<< closestPoints.iterations << " iterations and took: " << delta << " microseconds\n";
+	//Support queries along a slowly turning direction, scanning every vertex against hill climbing from the last result
+	const unsigned int supportQueries = 10000;
+	uint32_t supportID = 0, supportSum = 0;
+	startTime = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < supportQueries; ++i)
+	{
+		supportSum += sphere.supportPoint(vec3(std::cos(0.01f * i), std::sin(0.01f * i), 0.5f));
+	}
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Sphere " << supportQueries << " scanned support queries took: " << delta << " microseconds (" << supportSum << ")\n";
+	supportSum = 0;
+	startTime = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < supportQueries; ++i)
+	{
+		supportID = sphere.supportPointFrom(vec3(std::cos(0.01f * i), std::sin(0.01f * i), 0.5f), supportID);
+		supportSum += supportID;
+	}
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Sphere " << supportQueries << " hill climbed support queries took: " << delta << " microseconds (" << supportSum << ")\n";
+	//Dobkin-Kirkpatrick descent against the linear scan on refined spheres, random directions so no query can be warm started
+	std::vector<vec3> supportDirections(2000);
+	std::uniform_real_distribution<float> unitRange(-1.0f, 1.0f);
+	for (vec3& direction : supportDirections)
+	{
+		direction = vec3(unitRange(nextVal), unitRange(nextVal), unitRange(nextVal));
+	}
+	const int sphereSegments[6] = { 16, 32, 64, 128, 256, 317 };
+	for (int i = 0; i < 6; ++i)
+	{
+		Shape refined = refinedSphere(sphereSegments[i], sphereSegments[i] - 1);
+		startTime = std::chrono::steady_clock::now();
+		SupportHierarchy hierarchy(refined);
+		delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << "Refined Sphere of " << refined.count << " vertices, hierarchy of " << hierarchy.getLevelCount() << " levels built in: " << delta << " microseconds\n";
+		supportSum = 0;
+		startTime = std::chrono::steady_clock::now();
+		for (const vec3& direction : supportDirections)
+		{
+			supportSum += refined.supportPoint(direction);
+		}
+		delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << "	" << supportDirections.size() << " scanned support queries took: " << delta << " microseconds (" << supportSum << ")\n";
+		supportSum = 0;
+		startTime = std::chrono::steady_clock::now();
+		for (const vec3& direction : supportDirections)
+		{
+			supportSum += hierarchy.supportPoint(direction);
+		}
+		delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << "	" << supportDirections.size() << " hierarchy support queries took: " << delta << " microseconds (" << supportSum << ")\n";
+		//Ties may pick different vertices, so the answers are compared by how far they reach along the direction
+		int mismatches = 0;
+		for (const vec3& direction : supportDirections)
+		{
+			float scanned = dot(direction, refined.vertices[refined.supportPoint(direction)]);
+			float climbed = dot(direction, refined.vertices[hierarchy.supportPoint(direction)]);
+			if (scanned - climbed > 1e-5f * std::sqrt(dot(direction, direction)))++mismatches;
+		}
+		std::cout << "	" << mismatches << " of " << supportDirections.size() << " hierarchy support points differ from the scan\n";
+		//The hierarchy in place of the mesh in GJK, against the Sphere placed around it
+		float worstDistance = 0.0f;
+		long long scannedTime = 0, climbedTime = 0;
+		for (const vec3& direction : supportDirections)
+		{
+			vec3 offset = direction * 3.0f;
+			startTime = std::chrono::steady_clock::now();
+			float scanned = gjkDistance(refined, sphere, offset);
+			scannedTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+			startTime = std::chrono::steady_clock::now();
+			float climbed = gjkDistance(hierarchy, sphere, offset);
+			climbedTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+			worstDistance = std::max(worstDistance, std::abs(scanned - climbed));
+		}
+		std::pair<float, float> scannedToI = gjkToI(refined, sphere, vec3(5.0f, 0.5f, 0.0f), vec3(-5.0f, 0.0f, 0.0f));
+		std::pair<float, float> climbedToI = gjkToI(hierarchy, sphere, vec3(5.0f, 0.5f, 0.0f), vec3(-5.0f, 0.0f, 0.0f));
+		std::cout << "	" << supportDirections.size() << " distances to Sphere, scanned took: " << scannedTime << " microseconds, hierarchy took: " << climbedTime
+			<< " microseconds, worst difference: " << worstDistance << ", Time scanned: " << scannedToI.first << " hierarchy: " << climbedToI.first << "\n";
+		refined.buildSupportCache();
+		supportSum = 0;
+		startTime = std::chrono::steady_clock::now();
+		for (const vec3& direction : supportDirections)
+		{
+			supportSum += refined.supportPointFrom(direction, 0);
+		}
+		delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << "	" << supportDirections.size() << " cache seeded support queries took: " << delta << " microseconds (" << supportSum << ")\n";
+	}
+	//Quickhull of a 100k vertex sphere, serial against assigning points over the pool, both must give the same hull
+	{
+		Shape refined = refinedSphere(317, 316);
+		startTime = std::chrono::steady_clock::now();
+		Shape serialHull = convexHull(refined);
+		delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << "Hull of " << refined.count << " vertices, serial took: " << delta << " microseconds";
+		startTime = std::chrono::steady_clock::now();
+		Shape pooledHull = convexHull(refined, nullptr, &pool);
+		delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		bool same = serialHull.count == pooledHull.count && serialHull.faceCount == pooledHull.faceCount;
+		for (int i = 0; same && i < serialHull.count; ++i)
+		{
+			vec3 offset = serialHull.vertices[i] - pooledHull.vertices[i];
+			same = dot(offset, offset) == 0.0f;
+		}
+		std::cout << ", pooled took: " << delta << " microseconds, " << pooledHull.count << " hull vertices, " << (same ? "same hull" : "hulls differ") << "\n";
+	}
+	//Locality, a hull comes out in the order quickhull found its points, walks and face loops before and after renumbering
+	{
+		Shape scattered = convexHull(refinedSphere(256, 255));
+		for (int pass = 0; pass < 2; ++pass)
+		{
+			if (pass == 1)
+			{
+				startTime = std::chrono::steady_clock::now();
+				scattered.reorderForLocality();
+				delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+				std::cout << "Hull of " << scattered.count << " vertices reordered in: " << delta << " microseconds\n";
+			}
+			supportSum = 0;
+			supportID = 0;
+			startTime = std::chrono::steady_clock::now();
+			for (unsigned int i = 0; i < supportQueries; ++i)
+			{
+				supportID = scattered.supportPointFrom(vec3(std::cos(0.01f * i), std::sin(0.01f * i), 0.5f), supportID);
+				supportSum += static_cast<uint32_t>(dot(scattered.vertices[supportID], vec3(1.0f)) * 1000.0f);
+			}
+			delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+			std::cout << ((pass == 0) ? "	Quickhull order " : "	Morton order ") << supportQueries << " hill climbed support queries took: " << delta << " microseconds (" << supportSum << ")\n";
+			float area = 0.0f;
+			startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < scattered.faceCount; ++i)
+			{
+				const Indices3& face = scattered.faceVerts[i];
+				vec3 normal = cross(scattered.vertices[face.ind[1]] - scattered.vertices[face.ind[0]], scattered.vertices[face.ind[2]] - scattered.vertices[face.ind[0]]);
+				area += 0.5f * std::sqrt(dot(normal, normal));
+			}
+			delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+			std::cout << ((pass == 0) ? "	Quickhull order " : "	Morton order ") << scattered.faceCount << " face loop took: " << delta << " microseconds (" << area << ")\n";
+		}
+	}
+	//Deformation, a ripple moving 1% and then 5% of the vertices per frame, incremental face updates against recomputing every face
+	//	The 5% ripple changes more faces than faceUpdateParallelThreshold, so its updates go through the pool
+	for (int percent : { 1, 5 })
+	{
+		Shape deforming = refinedSphere(256, 255);
+		const int frames = 10;
+		const int movedPerFrame = deforming.count * percent / 100;
+		long long incremental = 0, full = 0;
+		int changedFaces = 0, pooledFrames = 0;
+		for (int frame = 0; frame < frames; ++frame)
+		{
+			for (int i = 0; i < movedPerFrame; ++i)
+			{
+				int index = (frame * movedPerFrame + i) % deforming.count;
+				deforming.moveVertex(index, deforming.vertices[index] * (1.0f + 0.01f * std::sin(0.1f * (frame + i))));
+			}
+			startTime = std::chrono::steady_clock::now();
+			int changed = deforming.updateFaces(&pool);
+			incremental += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+			changedFaces += changed;
+			if (changed >= faceUpdateParallelThreshold)++pooledFrames;
+			startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < deforming.faceCount; ++i)
+			{
+				deforming.recomputeFace(i);
+			}
+			full += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		}
+		std::cout << "Deforming Sphere of " << deforming.faceCount << " faces, " << percent << "% moved, " << frames << " frames (" << pooledFrames << " pooled) updated "
+			<< changedFaces << " faces in: " << incremental << " microseconds, recomputing all faces took: " << full << " microseconds\n";
+	}
+	//Reference faces, scanning every face against walking the half-edge fan of the support vertex
+	HalfEdgeMesh sphereEdges(sphere);
+	supportSum = 0;
+	startTime = std::chrono::steady_clock::now();
+	for (const vec3& direction : supportDirections)
+	{
+		uint32_t best = 0;
+		for (int i = 1; i < sphere.faceCount; ++i)
+		{
+			if (dot(sphere.faces[i], direction) > dot(sphere.faces[best], direction))best = i;
+		}
+		supportSum += best;
+	}
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Sphere " << supportDirections.size() << " scanned reference faces took: " << delta << " microseconds (" << supportSum << ")\n";
+	supportSum = 0;
+	supportID = 0;
+	startTime = std::chrono::steady_clock::now();
+	for (const vec3& direction : supportDirections)
+	{
+		supportID = sphere.supportPointFrom(direction, supportID);
+		supportSum += sphereEdges.supportFace(direction, supportID);
+	}
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Sphere " << supportDirections.size() << " half-edge reference faces took: " << delta << " microseconds (" << supportSum << ")\n";
 	
 	//ToI GJK
 	velocity = vec3(-5.0f, 0.0f, 0.0f);
@@ -381,29 +778,181 @@ int main()
 	timeDistance = gjkToI(sphere, sphere, translation, velocity);
 	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
 	std::cout << "Sphere to Sphere Time is: " << timeDistance.first << " and took: " << delta << " microseconds\n";
+	startTime = std::chrono::steady_clock::now();
+	timeDistance = gjkToI(implicitSphere, implicitSphere, translation, velocity);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Implicit Sphere to Sphere Time is: " << timeDistance.first << " and took: " << delta << " microseconds\n";
+	startTime = std::chrono::steady_clock::now();
+	timeDistance = gjkToI(sphereLods, transform(), sphereLods, transform(translation), velocity);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "LOD Sphere to Sphere Time is: " << timeDistance.first << " and took: " << delta << " microseconds\n";
+	//Concave mesh, a dumbbell's convex pieces against its single hull, with a sphere beside the neck where the hull is solid
+	{
+		Shape dumbbell = refinedDumbbell(32, 31);
+		startTime = std::chrono::steady_clock::now();
+		CompoundShape dumbbellPieces = convexDecomposition(dumbbell);
+		delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << "Dumbbell of " << dumbbell.count << " vertices decomposed into " << dumbbellPieces.pieceCount << " pieces in: " << delta << " microseconds\n";
+		Shape dumbbellHull = convexHull(dumbbell);
+		SphereShape ball(0.5f);
+		vec3 besideNeck(1.0f, 0.0f, 0.0f);
+		startTime = std::chrono::steady_clock::now();
+		distance = gjkDistance(dumbbellPieces, ball, besideNeck);
+		delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << "Dumbbell pieces to Sphere distance is: " << distance << " and took: " << delta << " microseconds\n";
+		startTime = std::chrono::steady_clock::now();
+		distance = gjkDistance(dumbbellHull, ball, besideNeck);
+		delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << "Dumbbell hull to Sphere distance is: " << distance << " and took: " << delta << " microseconds\n";
+		startTime = std::chrono::steady_clock::now();
+		timeDistance = gjkToI(dumbbellPieces, ball, vec3(3.0f, 0.0f, 0.0f), velocity);
+		delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << "Dumbbell pieces to Sphere Time is: " << timeDistance.first << " and took: " << delta << " microseconds\n";
+		startTime = std::chrono::steady_clock::now();
+		timeDistance = gjkToI(dumbbellHull, ball, vec3(3.0f, 0.0f, 0.0f), velocity);
+		delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		std::cout << "Dumbbell hull to Sphere Time is: " << timeDistance.first << " and took: " << delta << " microseconds\n";
+	}
+	//Edge-edge ToI, Gauss map pruned pairs against every pair of edges, with B turned so its edges are not parallel to A's
+	GaussMap sphereGauss(sphereEdges);
+	transform turned(angleAxis(0.7f, normalize(vec3(1.0f, 2.0f, 3.0f))), translation);
+	std::vector<std::pair<int, int>> edgePairs;
+	startTime = std::chrono::steady_clock::now();
+	minkowskiEdgePairs(sphereGauss, sphereGauss, toMat3(turned.orientation), edgePairs);
+	float edgeTime = edgeEdgeToI(sphereGauss, sphereGauss, turned, velocity, edgePairs);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Sphere edge-edge Time is: " << edgeTime << " from " << edgePairs.size() << " Minkowski face pairs and took: " << delta << " microseconds\n";
+	std::vector<std::pair<int, int>> allPairs;
+	allPairs.reserve(sphereGauss.edgeCount * sphereGauss.edgeCount);
+	for (int i = 0; i < sphereGauss.edgeCount; ++i)
+	{
+		for (int j = 0; j < sphereGauss.edgeCount; ++j)
+		{
+			allPairs.push_back(std::make_pair(i, j));
+		}
+	}
+	startTime = std::chrono::steady_clock::now();
+	edgeTime = edgeEdgeToI(sphereGauss, sphereGauss, turned, velocity, allPairs);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Sphere edge-edge Time over all " << allPairs.size() << " pairs is: " << edgeTime << " and took: " << delta << " microseconds\n";
+
+	//Bounding volume early outs - a step that passes well clear, and a distance query culled beyond 1 unit
+	uint32_t bisections = 0;
+	startTime = std::chrono::steady_clock::now();
+	timeDistance = gjkToI(sphere, sphere, vec3(5.0f, 10.0f, 0.0f), velocity, &bisections);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Missing Sphere to Sphere Time is: " << timeDistance.first << " after " << bisections << " bisections and took: " << delta << " microseconds\n";
+	uint32_t iterations = 0;
+	startTime = std::chrono::steady_clock::now();
+	float culled = gjkDistance(sphere, sphere, vec3(5.0f, 10.0f, 0.0f), &iterations, 1.0f);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Culled Sphere to Sphere distance is at least: " << culled << " after " << iterations << " iterations and took: " << delta << " microseconds\n";
+	//Penetration - overlapping shapes resolved by one EPA query, then checked by moving B out along the normal
+	Penetration penetration;
+	const vec3 overlaps[2] = { vec3(1.5f, 0.3f, 0.1f), vec3(1.2f, 0.5f, 0.0f) };
+	const Shape* overlapping[2] = { &cube, &sphere };
+	const std::string overlapNames[2] = { "Cube", "Sphere" };
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		startTime = std::chrono::steady_clock::now();
+		gjkPenetration(*overlapping[i], *overlapping[i], overlaps[i], penetration);
+		delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		distance = gjkDistance(*overlapping[i], *overlapping[i], overlaps[i] + penetration.normal * (penetration.depth + 0.01f));
+		std::cout << "Overlapping " << overlapNames[i] << " to " << overlapNames[i] << " depth is: " << penetration.depth << " after " << penetration.iterations
+			<< " iterations and took: " << delta << " microseconds, moved out by it the distance is: " << distance << "\n";
+	}
+
+	//Instancing - many bodies sharing one immutable sphere, against deep copies of the mesh
+	const unsigned int bodyCount = 1000;
+	Geometry sphereGeometry = shareGeometry(Shape(sphere));
+	startTime = std::chrono::steady_clock::now();
+	std::vector<Shape> sphereCopies(bodyCount, sphere);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << bodyCount << " Sphere copies took: " << delta << " microseconds for " << (bodyCount * sphere.storageBytes()) << " bytes\n";
+	startTime = std::chrono::steady_clock::now();
+	std::vector<Body> sphereBodies;
+	sphereBodies.reserve(bodyCount);
+	for (unsigned int i = 0; i < bodyCount; ++i)
+	{
+		sphereBodies.push_back(Body(sphereGeometry, transform(vec3(3.0f * i, 0.0f, 0.0f))));
+	}
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << bodyCount << " Sphere bodies took: " << delta << " microseconds for " << (bodyCount * sizeof(Body) + sphereGeometry->storageBytes())
+		<< " bytes, geometry shared " << sphereGeometry.use_count() << " ways\n";
+	distance = 0.0f;
+	startTime = std::chrono::steady_clock::now();
+	for (unsigned int i = 1; i < bodyCount; ++i)
+	{
+		distance += gjkDistance(sphereBodies[i - 1], sphereBodies[i]);
+	}
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Neighboring Sphere bodies mean distance is: " << (distance / (bodyCount - 1)) << " and took: " << delta << " microseconds\n";
+	//Yes or no queries over the same neighbors, which stop at a separating axis instead of converging on the distance
+	unsigned int touching = 0;
+	startTime = std::chrono::steady_clock::now();
+	for (unsigned int i = 1; i < bodyCount; ++i)
+	{
+		if (gjkIntersect(sphereBodies[i - 1], sphereBodies[i]))++touching;
+	}
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Neighboring Sphere bodies intersecting: " << touching << " and took: " << delta << " microseconds\n";
+	touching = 0;
+	startTime = std::chrono::steady_clock::now();
+	for (unsigned int i = 1; i < bodyCount; ++i)
+	{
+		if (gjkWithinMargin(sphereBodies[i - 1], sphereBodies[i], 1.5f))++touching;
+	}
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Neighboring Sphere bodies within 1.5 units: " << touching << " and took: " << delta << " microseconds\n";
+
+	//Precision Tests - float against double, near the origin and at large world coordinates
+	std::cout << "Worst relative error of 1/sqrt, Estimate: " << worstInverseSqrtError<SqrtPrecision::Estimate, float>()
+		<< ", Refined: " << worstInverseSqrtError<SqrtPrecision::Refined, float>() << " (float), " << worstInverseSqrtError<SqrtPrecision::Refined, double>()
+		<< " (double), Exact float: " << worstInverseSqrtError<SqrtPrecision::Exact, float>() << "\n";
+	dShape cubeD(cube), suzanneD(suzanne), sphereD(sphere);
+	dvec3 translationD(translation), velocityD(velocity);
+	vec3 farOrigin(12345.67f, -4321.5f, 9876.25f);
+	dvec3 farOriginD(12345.67, -4321.5, 9876.25);
+	precisionTrial("float Cube to Cube", cube, vec3(0.0f), translation, velocity);
+	precisionTrial("double Cube to Cube", cubeD, dvec3(0.0), translationD, velocityD);
+	precisionTrial("float Suzanne to Suzanne", suzanne, vec3(0.0f), translation, velocity);
+	precisionTrial("double Suzanne to Suzanne", suzanneD, dvec3(0.0), translationD, velocityD);
+	precisionTrial("float Sphere to Sphere", sphere, vec3(0.0f), translation, velocity);
+	precisionTrial("double Sphere to Sphere", sphereD, dvec3(0.0), translationD, velocityD);
+	precisionTrial("float far Sphere to Sphere", sphere, farOrigin, translation, velocity);
+	precisionTrial("double far Sphere to Sphere", sphereD, farOriginD, translationD, velocityD);
 
 	//Projection Timing Tests
 	//Box
 	startTime = std::chrono::steady_clock::now();
-	pool.dispatch(8, &hyperplaneCubeAllFacesToI);
+	pool.dispatch(cube.count, &hyperplaneCubeAllFacesToI);
 	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
 	std::cout << "Cube all faces tested: " << delta << " microseconds\n";
 	//Suzanne
 	startTime = std::chrono::steady_clock::now();
-	pool.dispatch(66, &hyperplaneSuzanneAllFacesToI);
+	pool.dispatch(suzanne.count, &hyperplaneSuzanneAllFacesToI);
 	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
 	std::cout << "Suzanne all faces tested: " << delta << " microseconds\n";
 	//Sphere
 	startTime = std::chrono::steady_clock::now();
-	pool.dispatch(242, &hyperplaneSphereAllFacesToI);
+	pool.dispatch(sphere.count, &hyperplaneSphereAllFacesToI);
 	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
 	std::cout << "Sphere all faces tested: " << delta << " microseconds\n";
+	startTime = std::chrono::steady_clock::now();
+	pool.dispatch(sphere.count, &hyperplaneSphereLodToI);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Sphere LOD first tested: " << delta << " microseconds\n";
+	//	Quantized Sphere
+	startTime = std::chrono::steady_clock::now();
+	pool.dispatch(quantizedSphere.count, &hyperplaneQuantizedSphereAllFacesToI);
+	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	std::cout << "Quantized Sphere all faces tested: " << delta << " microseconds\n";
 	//Culling Performance
 	//	Suzanne
 	startTime = std::chrono::steady_clock::now();
-	pool.dispatch(128, &hyperplaneCullSuzanne);
+	pool.dispatch(suzanne.faceCount, &hyperplaneCullSuzanne);
 
-	for (int i = 0; i < 128; ++i)
+	for (int i = 0; i < suzanne.faceCount; ++i)
 	{
 		if (validFaces[i])
 		{
@@ -415,15 +964,15 @@ int main()
 	std::cout << "Suzanne Culling time: " << delta << " microseconds\n";
 
 	startTime = std::chrono::steady_clock::now();
-	pool.dispatch(66, &hyperplaneReducedSuzanne);
+	pool.dispatch(suzanne.count, &hyperplaneReducedSuzanne);
 	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
 	std::cout << "Suzanne Reduced time: " << delta << " microseconds\n";
 	//	Sphere
 	testCount = 0;
 	startTime = std::chrono::steady_clock::now();
-	pool.dispatch(480, &hyperplaneCullSphere);
+	pool.dispatch(sphere.faceCount, &hyperplaneCullSphere);
 
-	for (int i = 0; i < 480; ++i)
+	for (int i = 0; i < sphere.faceCount; ++i)
 	{
 		if (validFaces[i])
 		{
@@ -435,7 +984,7 @@ int main()
 	std::cout << "Sphere Culling time: " << delta << " microseconds\n";
 
 	startTime = std::chrono::steady_clock::now();
-	pool.dispatch(242, &hyperplaneReducedSphere);
+	pool.dispatch(sphere.count, &hyperplaneReducedSphere);
 	delta = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
 	std::cout << "Sphere Reduced time: " << delta << " microseconds\n";
 